@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include "consensus/pbft_chain.hpp"
+#include "consensus/vote.hpp"
+#include "dag/vdf_sortition.hpp"
+#include "util_test/samples.hpp"
+
+namespace taraxa::benchmarks {
+
+using vdf_sortition::VdfConfig;
+using vdf_sortition::VdfSortition;
+using vrf_wrapper::vrf_sk_t;
+
+const uint32_t kVotesNum = 100;
+
+vrf_sk_t const kVrfSk(
+    "0b6627a6680e01cea3d9f36fa797f7f34e8869c3a526d9ed63ed8170e35542aad05dc12c"
+    "1df1edc9f3367fba550b7971fc2de6c5998d8784051c5be69abc9644");
+
+// Votes as received from the network: decoded from rlp, signature checked and voter recovered, vrf proof verified
+void voteVerify(benchmark::State &state) {
+  auto const node_sk = core_tests::samples::TX_GEN->getRandomUniqueSenderSecret();
+  std::vector<bytes> rlps;
+  for (uint32_t i = 0; i < kVotesNum; ++i) {
+    VrfPbftSortition sortition(kVrfSk, VrfPbftMsg(blk_hash_t(i), PbftVoteTypes::cert_vote_type, i + 1, 3));
+    rlps.push_back(Vote(node_sk, sortition, blk_hash_t(i)).rlp());
+  }
+  for (auto _ : state) {
+    for (auto const &rlp : rlps) {
+      Vote vote(rlp);
+      benchmark::DoNotOptimize(vote.verifyVote());
+      benchmark::DoNotOptimize(vote.getVrfSortition().verify());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * rlps.size());
+}
+
+// Verification of a received DAG block proposal, state.range(0) is the vdf difficulty
+void vdfVerify(benchmark::State &state) {
+  uint16_t const difficulty = state.range(0);
+  // Nothing is omitted and difficulty range is of a single value
+  VdfConfig const config(0xffff, 0, difficulty, difficulty + 1, difficulty, 1500);
+  auto const node_addr = addr_t(12345);
+  level_t const level = 3;
+  blk_hash_t const vdf_input(200);
+  VdfSortition vdf(config, node_addr, kVrfSk, getRlpBytes(level));
+  vdf.computeVdfSolution(config, vdf_input.asBytes());
+  auto const rlp = vdf.rlp();
+  for (auto _ : state) {
+    VdfSortition received(node_addr, rlp);
+    benchmark::DoNotOptimize(received.verifyVdf(config, getRlpBytes(level), vdf_input.asBytes()));
+  }
+}
+
+BENCHMARK(voteVerify);
+BENCHMARK(vdfVerify)->Arg(10)->Arg(16)->Unit(benchmark::kMillisecond);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "dag/dag.hpp"
+
+namespace taraxa::benchmarks {
+
+// Layered DAG as produced by a network of kWidth proposers: every block of a level points with its pivot edge to the
+// block of the previous level with the same index and with a tip edge to the next one
+const uint32_t kWidth = 8;
+
+struct DagShape {
+  struct Block {
+    std::string hash;
+    std::string pivot;
+    std::vector<std::string> tips;
+  };
+
+  std::string genesis = blk_hash_t(0).toString();
+  std::vector<Block> blocks;
+  std::map<uint64_t, std::vector<std::string>> levels;
+
+  explicit DagShape(uint32_t blocks_num) {
+    for (uint32_t i = 0; i < blocks_num; ++i) {
+      auto const level = i / kWidth + 1;
+      auto const index = i % kWidth;
+      Block b{blk_hash_t(i + 1).toString(), genesis, {}};
+      if (level > 1) {
+        auto const prev_level_start = (level - 2) * kWidth;
+        b.pivot = blocks[prev_level_start + index].hash;
+        b.tips.push_back(blocks[prev_level_start + (index + 1) % kWidth].hash);
+      }
+      levels[level].push_back(b.hash);
+      blocks.push_back(std::move(b));
+    }
+  }
+
+  template <typename Graph>
+  void addTo(Graph &graph, bool with_tips) const {
+    static const std::vector<std::string> no_tips;
+    for (auto const &b : blocks) {
+      graph.addVEEs(b.hash, b.pivot, with_tips ? b.tips : no_tips);
+    }
+  }
+};
+
+void addVEEs(benchmark::State &state) {
+  DagShape const shape(state.range(0));
+  for (auto _ : state) {
+    Dag dag(shape.genesis, addr_t());
+    shape.addTo(dag, true);
+    benchmark::DoNotOptimize(dag.getNumEdges());
+  }
+  state.SetItemsProcessed(state.iterations() * shape.blocks.size());
+}
+
+void getGhostPath(benchmark::State &state) {
+  DagShape const shape(state.range(0));
+  PivotTree tree(shape.genesis, addr_t());
+  shape.addTo(tree, false);
+  std::vector<std::string> ghost;
+  for (auto _ : state) {
+    tree.getGhostPath(shape.genesis, ghost);
+    benchmark::DoNotOptimize(ghost.data());
+  }
+  state.SetItemsProcessed(state.iterations() * shape.blocks.size());
+}
+
+// Orders all the non finalized blocks, anchor is a block of the last level
+void computeOrder(benchmark::State &state) {
+  DagShape const shape(state.range(0));
+  Dag dag(shape.genesis, addr_t());
+  shape.addTo(dag, true);
+  auto const &anchor = shape.levels.rbegin()->second.front();
+  std::vector<std::string> order;
+  for (auto _ : state) {
+    dag.computeOrder(anchor, order, shape.levels);
+    benchmark::DoNotOptimize(order.data());
+  }
+  state.SetItemsProcessed(state.iterations() * shape.blocks.size());
+}
+
+BENCHMARK(addVEEs)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK(getGhostPath)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK(computeOrder)->RangeMultiplier(4)->Range(256, 4096);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
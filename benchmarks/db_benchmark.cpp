@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+#include <libdevcore/SHA3.h>
+
+#include <random>
+
+#include "storage/db_storage.hpp"
+
+namespace taraxa::benchmarks {
+
+// Replays the same access pattern of the transaction/DAG hot path against the db opened with rocksdb default options
+// and with the default DbConfig column profiles. The pattern is recorded once (from a fixed seed) before the first run:
+// gossiped transactions are checked for presence, new ones get their status looked up and are stored, known ones are
+// checked for being executed, and DAG blocks are read.
+const uint32_t kPreloadedTrxs = 200000;
+const uint32_t kPreloadedBlocks = 20000;
+const uint32_t kAccessesNum = 100000;
+const size_t kTrxSize = 150;
+const size_t kBlockSize = 1024;
+
+enum class Op : uint8_t { trx_in_db, trx_status_get, trx_insert, executed_get, dag_block_get };
+
+struct Access {
+  Op op;
+  uint32_t key;
+};
+
+std::vector<Access> const &recordedAccesses() {
+  static auto const accesses = [] {
+    std::vector<Access> ret;
+    std::mt19937 gen(42);
+    // Most of the gossiped transactions are recent ones
+    std::uniform_int_distribution<uint32_t> recent_trx(kPreloadedTrxs - kPreloadedTrxs / 10, kPreloadedTrxs - 1);
+    std::uniform_int_distribution<uint32_t> any_trx(0, kPreloadedTrxs - 1);
+    std::uniform_int_distribution<uint32_t> block(0, kPreloadedBlocks - 1);
+    std::uniform_int_distribution<uint32_t> percent(0, 99);
+    uint32_t next_new_trx = kPreloadedTrxs;
+    while (ret.size() < kAccessesNum) {
+      if (auto const p = percent(gen); p < 40) {
+        auto const key = next_new_trx++;
+        ret.push_back({Op::trx_in_db, key});
+        ret.push_back({Op::trx_status_get, key});
+        ret.push_back({Op::trx_insert, key});
+      } else if (p < 80) {
+        auto const key = percent(gen) < 80 ? recent_trx(gen) : any_trx(gen);
+        ret.push_back({Op::trx_in_db, key});
+        ret.push_back({Op::executed_get, key});
+      } else {
+        ret.push_back({Op::dag_block_get, block(gen)});
+      }
+    }
+    return ret;
+  }();
+  return accesses;
+}
+
+h256 key(uint32_t i) { return dev::sha3(dev::toBigEndian(dev::u256(i))); }
+
+DbConfig dbConfig(bool tuned) {
+  if (tuned) {
+    return {};
+  }
+  DbConfig ret;
+  ret.block_cache_size = 0;
+  ret.max_background_jobs = 0;
+  ret.profiles.clear();
+  ret.columns.clear();
+  return ret;
+}
+
+std::filesystem::path dbPath(bool tuned) {
+  return std::filesystem::temp_directory_path() / (tuned ? "taraxa_db_benchmark_tuned" : "taraxa_db_benchmark_default");
+}
+
+std::shared_ptr<DbStorage> g_db;
+
+void openDb(benchmark::State const &state) {
+  bool const tuned = state.range(0);
+  auto const path = dbPath(tuned);
+  std::filesystem::remove_all(path);
+  {
+    DbStorage db(path, 0, 0, 0, addr_t(), false, dbConfig(tuned));
+    std::string const trx(kTrxSize, 't'), blk(kBlockSize, 'b');
+    auto batch = DbStorage::createWriteBatch();
+    for (uint32_t i = 0; i < kPreloadedTrxs; ++i) {
+      auto const k = key(i);
+      db.batch_put(*batch, DbStorage::Columns::transactions, k, trx);
+      db.batch_put(*batch, DbStorage::Columns::trx_status, k, (uint16_t)TransactionStatus::in_block);
+      if (i % 2 == 0) {
+        db.batch_put(*batch, DbStorage::Columns::executed_transactions, k, true);
+      }
+      if (i < kPreloadedBlocks) {
+        db.batch_put(*batch, DbStorage::Columns::dag_blocks, k, blk);
+      }
+      if (batch->Count() >= 10000) {
+        db.commitWriteBatch(batch);
+        batch = DbStorage::createWriteBatch();
+      }
+    }
+    db.commitWriteBatch(batch);
+  }
+  // Reopening flushes the memtables, so the lookups hit sst files as they do on a long running node
+  g_db = std::make_shared<DbStorage>(path, 0, 0, 0, addr_t(), false, dbConfig(tuned));
+}
+
+void closeDb(benchmark::State const &state) {
+  g_db.reset();
+  std::filesystem::remove_all(dbPath(state.range(0)));
+}
+
+void replay(benchmark::State &state) {
+  auto const &accesses = recordedAccesses();
+  std::string const trx(kTrxSize, 't');
+  for (auto _ : state) {
+    for (auto const &a : accesses) {
+      auto const k = key(a.key);
+      switch (a.op) {
+        case Op::trx_in_db:
+          benchmark::DoNotOptimize(g_db->transactionInDb(k));
+          break;
+        case Op::trx_status_get:
+          benchmark::DoNotOptimize(g_db->getTransactionStatus(k));
+          break;
+        case Op::trx_insert:
+          g_db->insert(DbStorage::Columns::transactions, DbStorage::toSlice(k), DbStorage::toSlice(trx));
+          g_db->saveTransactionStatus(k, TransactionStatus::in_queue_unverified);
+          break;
+        case Op::executed_get:
+          benchmark::DoNotOptimize(g_db->lookup(k, DbStorage::Columns::executed_transactions));
+          break;
+        case Op::dag_block_get:
+          benchmark::DoNotOptimize(g_db->lookup(k, DbStorage::Columns::dag_blocks));
+          break;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * accesses.size());
+}
+
+// Lookups of the gossiped transactions done in batches of state.range(1) keys, as DAG block transactions are read
+void multiGet(benchmark::State &state) {
+  std::vector<h256> keys;
+  for (auto const &a : recordedAccesses()) {
+    if (a.op == Op::executed_get) {
+      keys.push_back(key(a.key));
+    }
+  }
+  size_t const batch_size = state.range(1);
+  DbStorage::MultiGetQuery query(g_db, batch_size);
+  for (auto _ : state) {
+    for (size_t i = 0; i + batch_size <= keys.size(); i += batch_size) {
+      query.append(DbStorage::Columns::transactions, std::vector(keys.begin() + i, keys.begin() + i + batch_size));
+      benchmark::DoNotOptimize(query.execute());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (keys.size() - keys.size() % batch_size));
+}
+
+// Arg 0 - rocksdb defaults, 1 - default DbConfig column profiles
+BENCHMARK(replay)->Arg(0)->Arg(1)->Setup(openDb)->Teardown(closeDb)->Unit(benchmark::kMillisecond);
+BENCHMARK(multiGet)
+    ->ArgsProduct({{0, 1}, {16, 256}})
+    ->Setup(openDb)
+    ->Teardown(closeDb)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <libdevcore/SHA3.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "util/flat_hash.hpp"
+
+// Every allocation of the process is counted, so the number of allocations per iteration can be reported
+static std::atomic<uint64_t> g_allocations = 0;
+
+void *operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace taraxa::benchmarks {
+
+// Per-block work sets: state.range(0) hashes (a quarter of them duplicates) are deduplicated and then looked up, the
+// same pattern as transaction hashes of a block or DAG blocks of a period
+std::vector<dev::h256> makeHashes(size_t count) {
+  std::vector<dev::h256> ret;
+  for (uint64_t i = 0; i < count; ++i) {
+    ret.emplace_back(dev::sha3(dev::toBigEndian(dev::u256(i % (count - count / 4)))));
+  }
+  return ret;
+}
+
+template <typename Set>
+void insertOrCount(Set &set, dev::h256 const &hash) {
+  if constexpr (std::is_same_v<Set, util::FlatHashSet<dev::h256>>) {
+    benchmark::DoNotOptimize(set.insert(hash));
+  } else {
+    benchmark::DoNotOptimize(set.insert(hash).second);
+  }
+}
+
+template <typename Set>
+void hashSet(benchmark::State &state) {
+  auto const hashes = makeHashes(state.range(0));
+  auto const allocations_before = g_allocations.load();
+  for (auto _ : state) {
+    Set set;
+    if constexpr (!std::is_same_v<Set, std::set<dev::h256>>) {
+      set.reserve(hashes.size());
+    }
+    for (auto const &h : hashes) {
+      insertOrCount(set, h);
+    }
+    for (auto const &h : hashes) {
+      benchmark::DoNotOptimize(set.count(h));
+    }
+  }
+  state.counters["allocs_per_iter"] = benchmark::Counter(double(g_allocations.load() - allocations_before) /
+                                                         static_cast<double>(state.iterations()));
+  state.SetItemsProcessed(state.iterations() * hashes.size() * 2);
+}
+
+// Weights of graph vertices (pointers, as the DAG uses hash_setS vertex storage) like in PivotTree::getGhostPath
+template <typename Map>
+void vertexWeights(benchmark::State &state) {
+  std::vector<std::unique_ptr<int>> vertices;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    vertices.emplace_back(std::make_unique<int>(i));
+  }
+  auto const allocations_before = g_allocations.load();
+  for (auto _ : state) {
+    Map weights(vertices.size());
+    size_t total = 0;
+    for (auto const &v : vertices) {
+      weights[v.get()] = ++total;
+    }
+    for (auto const &v : vertices) {
+      if constexpr (std::is_same_v<Map, std::unordered_map<int *, size_t>>) {
+        total += weights.find(v.get())->second;
+      } else {
+        total += *weights.find(v.get());
+      }
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.counters["allocs_per_iter"] = benchmark::Counter(double(g_allocations.load() - allocations_before) /
+                                                         static_cast<double>(state.iterations()));
+  state.SetItemsProcessed(state.iterations() * vertices.size() * 2);
+}
+
+BENCHMARK_TEMPLATE(hashSet, std::set<dev::h256>)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK_TEMPLATE(hashSet, std::unordered_set<dev::h256>)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK_TEMPLATE(hashSet, util::FlatHashSet<dev::h256>)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK_TEMPLATE(vertexWeights, std::unordered_map<int *, size_t>)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK_TEMPLATE(vertexWeights, util::FlatHashMap<int *, size_t>)->RangeMultiplier(8)->Range(64, 32768);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <libdevcore/SHA3.h>
+
+#include <filesystem>
+
+#include "logger/log.hpp"
+#include "util/util.hpp"
+
+namespace taraxa::benchmarks {
+
+// Logging overhead of a transaction flood: every received transaction produces the TMSTM timestamp line (as in
+// TransactionManager::insertBroadcastedTransactions) and a debug line which is usually filtered out
+const addr_t kNodeAddr(1);
+
+std::unique_ptr<logger::Config> g_logging;
+
+std::vector<trx_hash_t> const &hashes() {
+  static auto const hashes = [] {
+    std::vector<trx_hash_t> ret;
+    for (uint64_t i = 0; i < 1024; ++i) {
+      ret.emplace_back(dev::sha3(dev::toBigEndian(dev::u256(i))));
+    }
+    return ret;
+  }();
+  return hashes;
+}
+
+void initLogging(bool time_channel_on, bool async) {
+  g_logging = std::make_unique<logger::Config>();
+  g_logging->verbosity = logger::Verbosity::Error;
+  g_logging->channels["TRXMGR"] = logger::Verbosity::Info;
+  if (time_channel_on) {
+    g_logging->channels["TMSTM"] = logger::Verbosity::Info;
+  }
+  g_logging->async = async;
+  logger::Config::OutputConfig output;
+  output.type = "file";
+  output.file_name = (std::filesystem::temp_directory_path() / "taraxa_logging_benchmark_%N.log").string();
+  output.time_based_rotation = "0,0,0";
+  output.rotation_size = 100 * 1024 * 1024;
+  g_logging->outputs.push_back(output);
+  g_logging->InitLogging(kNodeAddr);
+}
+
+// Records still queued by async sinks are written out here, outside of the measured time
+void deinitLogging(benchmark::State const &) { g_logging.reset(); }
+
+template <bool UseIsEnabled>
+void transactionFlood(benchmark::State &state) {
+  auto log_time = logger::createLogger(logger::Verbosity::Info, "TMSTM", kNodeAddr);
+  auto log_dg = logger::createLogger(logger::Verbosity::Debug, "TRXMGR", kNodeAddr);
+  auto const &trxs = hashes();
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    auto const &hash = trxs[i++ % trxs.size()];
+    if constexpr (UseIsEnabled) {
+      LOG(log_time) << "Transaction " << hash << " brkreceived at: " << getCurrentTimeMilliSeconds();
+      LOG(log_dg) << "Transaction " << hash << " inserted";
+    } else {
+      // Filtering done by the boost sinks only, as it was before the loggers knew whether they are enabled
+      BOOST_LOG(log_time) << "Transaction " << hash << " brkreceived at: " << getCurrentTimeMilliSeconds();
+      BOOST_LOG(log_dg) << "Transaction " << hash << " inserted";
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(transactionFlood, false)
+    ->Name("disabled_filtered_by_sinks")
+    ->Setup([](auto const &) { initLogging(false, false); })
+    ->Teardown(deinitLogging)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(transactionFlood, true)
+    ->Name("disabled")
+    ->Setup([](auto const &) { initLogging(false, false); })
+    ->Teardown(deinitLogging)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(transactionFlood, true)
+    ->Name("sync_file")
+    ->Setup([](auto const &) { initLogging(true, false); })
+    ->Teardown(deinitLogging)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(transactionFlood, true)
+    ->Name("async_file")
+    ->Setup([](auto const &) { initLogging(true, true); })
+    ->Teardown(deinitLogging)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <libdevcore/SHA3.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "util/rotating_bloom_filter.hpp"
+#include "util/util.hpp"
+
+// Tracks heap usage so that memory footprint of the compared containers can be reported
+static std::atomic<int64_t> g_allocated_bytes = 0;
+
+void *operator new(std::size_t size) {
+  auto ptr = static_cast<std::size_t *>(std::malloc(size + sizeof(std::size_t)));
+  if (!ptr) throw std::bad_alloc();
+  *ptr = size;
+  g_allocated_bytes += size;
+  return ptr + 1;
+}
+
+void operator delete(void *ptr) noexcept {
+  if (!ptr) return;
+  auto base = static_cast<std::size_t *>(ptr) - 1;
+  g_allocated_bytes -= *base;
+  std::free(base);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept { operator delete(ptr); }
+
+namespace taraxa::benchmarks {
+
+// Same sizes as used for TaraxaPeer::known_transactions_
+const uint32_t kItemsCount = 100000;
+const double kFalsePositiveRate = 0.001;
+
+std::vector<trx_hash_t> const &hashes() {
+  static auto const hashes = [] {
+    std::vector<trx_hash_t> ret;
+    ret.reserve(4 * kItemsCount);
+    for (uint64_t i = 0; i < 4 * kItemsCount; ++i) {
+      ret.emplace_back(dev::sha3(dev::toBigEndian(dev::u256(i))));
+    }
+    return ret;
+  }();
+  return hashes;
+}
+
+auto makeExpirationCache() { return std::make_unique<ExpirationCache<trx_hash_t>>(kItemsCount, kItemsCount / 10); }
+auto makeBloomFilter() {
+  return std::make_unique<util::RotatingBloomFilter<trx_hash_t>>(kItemsCount, kFalsePositiveRate);
+}
+
+template <typename Factory>
+void insert(benchmark::State &state, Factory factory) {
+  auto const &items = hashes();
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto const memory_before = g_allocated_bytes.load();
+    auto container = factory();
+    state.ResumeTiming();
+    for (auto const &item : items) {
+      container->insert(item);
+    }
+    state.PauseTiming();
+    state.counters["memory_bytes"] = g_allocated_bytes.load() - memory_before;
+    container.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+template <typename Factory>
+void lookup(benchmark::State &state, Factory factory) {
+  auto const &items = hashes();
+  static auto container = factory();
+  if (state.thread_index() == 0) {
+    container->clear();
+    for (uint32_t i = 0; i < kItemsCount; ++i) {
+      container->insert(items[i]);
+    }
+  }
+  // Half of the lookups hit known items, half miss
+  uint64_t found = 0, i = state.thread_index();
+  for (auto _ : state) {
+    found += container->count(items[i % (2 * kItemsCount)]);
+    i += 7;
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(insert, expiration_cache, makeExpirationCache)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(insert, rotating_bloom_filter, makeBloomFilter)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(lookup, expiration_cache, makeExpirationCache)->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(lookup, rotating_bloom_filter, makeBloomFilter)->ThreadRange(1, 8);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
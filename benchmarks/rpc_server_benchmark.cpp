@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include <jsonrpccpp/server/iclientconnectionhandler.h>
+
+#include <thread>
+
+#include "network/rpc/RpcServer.h"
+
+namespace taraxa::benchmarks {
+
+namespace http = boost::beast::http;
+using boost::asio::ip::tcp;
+
+// Measures RpcServer request throughput (QPS) without any api behind it, so only transport overhead is compared
+struct EchoHandler : jsonrpc::IClientConnectionHandler {
+  void HandleRequest(std::string const &request, std::string &response) override { response = request; }
+};
+
+const char *kRequestBody = R"({"jsonrpc":"2.0","id":1,"method":"eth_blockNumber","params":[]})";
+const uint16_t kThreadsNum = 5;
+
+struct Server {
+  boost::asio::io_context io;
+  tcp::endpoint ep{boost::asio::ip::make_address("127.0.0.1"), 17777};
+  EchoHandler handler;
+  std::shared_ptr<net::RpcServer> rpc = std::make_shared<net::RpcServer>(io, ep, addr_t());
+  std::vector<std::thread> threads;
+
+  Server() {
+    rpc->SetHandler(&handler);
+    rpc->StartListening();
+    for (uint16_t i = 0; i < kThreadsNum; ++i) {
+      threads.emplace_back([this] { io.run(); });
+    }
+  }
+  ~Server() {
+    rpc->StopListening();
+    io.stop();
+    for (auto &t : threads) t.join();
+  }
+};
+
+Server &server() {
+  static Server server;
+  return server;
+}
+
+http::request<http::string_body> makeRequest(bool keep_alive, int64_t batch_size = 0) {
+  http::request<http::string_body> req{http::verb::post, "/", 11};
+  req.set(http::field::content_type, "application/json");
+  req.keep_alive(keep_alive);
+  if (batch_size == 0) {
+    req.body() = kRequestBody;
+  } else {
+    req.body() = "[";
+    for (int64_t i = 0; i < batch_size; ++i) {
+      req.body() += (i == 0 ? "" : ",") + std::string(kRequestBody);
+    }
+    req.body() += "]";
+  }
+  req.prepare_payload();
+  return req;
+}
+
+// Connection per request, the only mode supported before keep-alive
+void new_connection_per_request(benchmark::State &state) {
+  auto const &ep = server().ep;
+  auto const req = makeRequest(false);
+  boost::asio::io_context io;
+  for (auto _ : state) {
+    boost::beast::tcp_stream stream(io);
+    stream.connect(ep);
+    http::write(stream, req);
+    boost::beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    http::read(stream, buffer, res);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Persistent connection with state.range(0) pipelined requests in flight
+void keep_alive(benchmark::State &state) {
+  auto const &ep = server().ep;
+  auto const pipeline_depth = state.range(0);
+  auto const req = makeRequest(true);
+  boost::asio::io_context io;
+  boost::beast::tcp_stream stream(io);
+  stream.connect(ep);
+  boost::beast::flat_buffer buffer;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < pipeline_depth; ++i) {
+      http::write(stream, req);
+    }
+    for (int64_t i = 0; i < pipeline_depth; ++i) {
+      http::response<http::string_body> res;
+      http::read(stream, buffer, res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * pipeline_depth);
+}
+
+// Single json-rpc batch request of state.range(0) elements per round trip, elements are executed on the batch pool
+void batch(benchmark::State &state) {
+  auto const &ep = server().ep;
+  auto const batch_size = state.range(0);
+  auto const req = makeRequest(true, batch_size);
+  boost::asio::io_context io;
+  boost::beast::tcp_stream stream(io);
+  stream.connect(ep);
+  boost::beast::flat_buffer buffer;
+  for (auto _ : state) {
+    http::write(stream, req);
+    http::response<http::string_body> res;
+    http::read(stream, buffer, res);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(new_connection_per_request)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(keep_alive)->Arg(1)->Arg(8)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(batch)->Arg(8)->Arg(64)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
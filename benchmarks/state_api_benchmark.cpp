@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "chain/state_api.hpp"
+#include "util_test/samples.hpp"
+
+namespace taraxa::benchmarks {
+
+using namespace state_api;
+
+// Value transfers of a single sender, every iteration executes and commits a block of state.range(0) of them. Nonce
+// check and gas fee are disabled (like in state_api_test) so the same transactions can be executed in every block.
+void transitionState(benchmark::State &state) {
+  auto const trxs = core_tests::samples::createSignedTrxSamples(0, state.range(0), dev::KeyPair::create().secret());
+  std::vector<EVMTransaction> evm_trxs;
+  for (auto const &t : trxs) {
+    evm_trxs.push_back({t.getSender(), t.getGasPrice(), t.getReceiver(), t.getNonce(), t.getValue(), t.getGas(),
+                        t.getData()});
+  }
+
+  ChainConfig chain_config;
+  chain_config.disable_block_rewards = true;
+  chain_config.execution_options.disable_nonce_check = true;
+  chain_config.execution_options.disable_gas_fee = true;
+  chain_config.eth_chain_config.dao_fork_block = BlockNumberNIL;
+  chain_config.genesis_balances[trxs.front().getSender()] = u256(1) << 200;
+
+  auto const db_path = std::filesystem::temp_directory_path() / "taraxa_state_api_benchmark";
+  std::filesystem::remove_all(db_path);
+  {
+    Opts opts;
+    opts.ExpectedMaxTrxPerBlock = state.range(0);
+    opts.MainTrieFullNodeLevelsToCache = 4;
+    StateAPI state_api([](auto n) { return h256(n); }, chain_config, opts, {db_path.string()});
+    EVMBlock const block{addr_t(1), std::numeric_limits<gas_t>::max(), 0, 0};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(state_api.transition_state(block, evm_trxs).StateRoot);
+      state_api.transition_state_commit();
+    }
+  }
+  std::filesystem::remove_all(db_path);
+  state.SetItemsProcessed(state.iterations() * evm_trxs.size());
+}
+
+// Value transfers to random accounts out of kAccountsNum existing ones, so state reads go deep into the main trie.
+// Every iteration executes a block of 1000 of them with the main trie full nodes cached to the depth of
+// state.range(0) levels, to choose the default of state_api::main_trie_full_node_levels_to_cache.
+void transitionStateTrieCache(benchmark::State &state) {
+  const uint32_t kAccountsNum = 100000;
+  const uint32_t kTrxsNum = 1000;
+  auto const sender = dev::KeyPair::create().address();
+  ChainConfig chain_config;
+  chain_config.disable_block_rewards = true;
+  chain_config.execution_options.disable_nonce_check = true;
+  chain_config.execution_options.disable_gas_fee = true;
+  chain_config.eth_chain_config.dao_fork_block = BlockNumberNIL;
+  chain_config.genesis_balances[sender] = u256(1) << 200;
+  for (uint32_t i = 1; i <= kAccountsNum; ++i) {
+    chain_config.genesis_balances[addr_t(i)] = 1;
+  }
+  std::mt19937 rng(kAccountsNum);
+  std::uniform_int_distribution<uint32_t> account_dist(1, kAccountsNum);
+
+  auto const db_path = std::filesystem::temp_directory_path() / "taraxa_state_api_benchmark";
+  std::filesystem::remove_all(db_path);
+  {
+    Opts opts;
+    opts.ExpectedMaxTrxPerBlock = kTrxsNum;
+    opts.MainTrieFullNodeLevelsToCache = state.range(0);
+    StateAPI state_api([](auto n) { return h256(n); }, chain_config, opts, {db_path.string()});
+    EVMBlock const block{addr_t(1), std::numeric_limits<gas_t>::max(), 0, 0};
+    std::vector<EVMTransaction> evm_trxs(kTrxsNum);
+    for (auto _ : state) {
+      state.PauseTiming();
+      for (auto &t : evm_trxs) {
+        t = {sender, 0, addr_t(account_dist(rng)), 0, 1, 21000, {}};
+      }
+      state.ResumeTiming();
+      benchmark::DoNotOptimize(state_api.transition_state(block, evm_trxs).StateRoot);
+      state_api.transition_state_commit();
+    }
+  }
+  std::filesystem::remove_all(db_path);
+  state.SetItemsProcessed(state.iterations() * kTrxsNum);
+}
+
+BENCHMARK(transitionState)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(transitionStateTrieCache)->DenseRange(0, 12, 2)->Unit(benchmark::kMillisecond);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include "consensus/block_proposer.hpp"
+#include "transaction_manager/transaction_queue.hpp"
+#include "util_test/samples.hpp"
+
+namespace taraxa::benchmarks {
+
+using core_tests::samples::createMockDagBlkSamples;
+using core_tests::samples::createSignedTrxSamples;
+
+const uint32_t kTrxsNum = 1000;
+const uint32_t kBlocksNum = 100;
+
+std::vector<Transaction> const &trxSamples() {
+  static auto const trxs = [] {
+    auto ret = createSignedTrxSamples(0, kTrxsNum, dev::KeyPair::create().secret());
+    // Hashes are known by the time transactions reach the queue
+    for (auto const &t : ret) {
+      t.getHash();
+    }
+    return ret;
+  }();
+  return trxs;
+}
+
+std::vector<bytes> const &trxRlpSamples() {
+  static auto const rlps = [] {
+    std::vector<bytes> ret;
+    for (auto const &t : trxSamples()) {
+      ret.push_back(*t.rlp());
+    }
+    return ret;
+  }();
+  return rlps;
+}
+
+void trxRlpDecode(benchmark::State &state) {
+  auto const &rlps = trxRlpSamples();
+  for (auto _ : state) {
+    for (auto const &rlp : rlps) {
+      Transaction trx(rlp, true);
+      benchmark::DoNotOptimize(trx.getHash());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * rlps.size());
+}
+
+void trxSenderRecovery(benchmark::State &state) {
+  auto const &rlps = trxRlpSamples();
+  for (auto _ : state) {
+    for (auto const &rlp : rlps) {
+      Transaction trx(rlp, true);
+      benchmark::DoNotOptimize(trx.getSender());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * rlps.size());
+}
+
+void dagBlockRlpRoundTrip(benchmark::State &state) {
+  // state.range(0) transactions per block
+  auto const blks = createMockDagBlkSamples(0, kBlocksNum, 0, state.range(0), 0);
+  for (auto _ : state) {
+    for (auto const &blk : blks) {
+      DagBlock decoded(blk.rlp(true));
+      benchmark::DoNotOptimize(decoded.getTrxs().size());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * blks.size());
+}
+
+// Verified transactions are inserted and then packed in chunks of state.range(0), as the block proposer does
+void trxQueueInsertPack(benchmark::State &state) {
+  auto const &trxs = trxSamples();
+  TransactionQueue queue(addr_t{});
+  for (auto _ : state) {
+    for (auto const &t : trxs) {
+      queue.insert(t, true);
+    }
+    benchmark::DoNotOptimize(queue.getNewVerifiedTrxSnapShot().size());
+    while (!queue.moveVerifiedTrxSnapShot(state.range(0)).empty()) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * trxs.size());
+}
+
+std::vector<trx_hash_t> const &trxHashSamples() {
+  static auto const hashes = [] {
+    std::vector<trx_hash_t> ret;
+    for (size_t i = 0; i < 10000; ++i) {
+      ret.push_back(trx_hash_t::random());
+    }
+    return ret;
+  }();
+  return hashes;
+}
+
+// Shard of a transaction as it used to be computed, from the hex string of the hash
+void trxShardFromHex(benchmark::State &state) {
+  auto const &hashes = trxHashSamples();
+  for (auto _ : state) {
+    for (auto const &h : hashes) {
+      benchmark::DoNotOptimize(std::stoull(h.toString().substr(0, 10), NULL, 16) % 3);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * hashes.size());
+}
+
+void trxShardFromBytes(benchmark::State &state) {
+  auto const &hashes = trxHashSamples();
+  for (auto _ : state) {
+    for (auto const &h : hashes) {
+      benchmark::DoNotOptimize(BlockProposer::getTrxShard(h, 3));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * hashes.size());
+}
+
+BENCHMARK(trxRlpDecode);
+BENCHMARK(trxSenderRecovery);
+BENCHMARK(dagBlockRlpRoundTrip)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(trxQueueInsertPack)->Arg(0)->Arg(250);
+BENCHMARK(trxShardFromHex);
+BENCHMARK(trxShardFromBytes);
+
+}  // namespace taraxa::benchmarks
+
+BENCHMARK_MAIN();
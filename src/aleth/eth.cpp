@@ -0,0 +1,49 @@
+#include "eth.hpp"
+
+#include <jsonrpccpp/common/exception.h>
+#include <libweb3jsonrpc/JsonHelper.h>
+
+namespace taraxa::aleth {
+using namespace dev;
+using namespace eth;
+using namespace std;
+using namespace jsonrpc;
+
+string Eth::eth_newFilter(Json::Value const& json) {
+  return toJS(filter_api_->newLogFilter(LogsQuery::fromJson(json)));
+}
+
+Json::Value Eth::eth_getFilterLogs(string const& filter_id) {
+  if (auto query = filter_api_->getLogsQuery(aleth::FilterAPI::FilterID(jsToInt(filter_id)))) {
+    return logs(*query);
+  }
+  return Json::Value(Json::arrayValue);
+}
+
+Json::Value Eth::eth_getLogs(Json::Value const& json) { return logs(LogsQuery::fromJson(json)); }
+
+Json::Value Eth::logs(LogsQuery const& query) const {
+  Json::Value ret(Json::arrayValue);
+  auto const latest = final_chain_->get_last_block()->number();
+  auto const from = query.from.value_or(latest), to = min(query.to.value_or(latest), latest);
+  if (from > to) {
+    return ret;
+  }
+  if (logs_limits_.max_block_range && to - from >= logs_limits_.max_block_range) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(
+        Errors::ERROR_RPC_INVALID_PARAMS,
+        "Block range is limited to " + to_string(logs_limits_.max_block_range) + " blocks, narrow the query"));
+  }
+  auto const logs = final_chain_->logs(query.filter, from, to, logs_limits_.max_results);
+  if (logs_limits_.max_results && logs.size() > logs_limits_.max_results) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(
+        Errors::ERROR_RPC_INVALID_PARAMS,
+        "Query returns more than " + to_string(logs_limits_.max_results) + " results, narrow the query"));
+  }
+  for (auto const& l : logs) {
+    ret.append(toJson(l));
+  }
+  return ret;
+}
+
+}  // namespace taraxa::aleth
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <libweb3jsonrpc/Eth.h>
+
+#include "chain/final_chain.hpp"
+#include "filter_api.hpp"
+
+namespace taraxa::aleth {
+
+// Bounds of the work a single logs query may take, 0 means no limit
+struct EthLogsLimits {
+  uint64_t max_block_range = 0;
+  size_t max_results = 0;
+};
+
+// Serves the logs queries (eth_getLogs, eth_getFilterLogs) from the final chain log index instead of scanning blocks,
+// the rest is handled by dev::rpc::Eth
+struct Eth : dev::rpc::Eth {
+  template <typename NodeAPIPtr, typename StateAPIPtr, typename PendingBlockPtr, typename SyncingFn>
+  Eth(EthLogsLimits const& logs_limits, NodeAPIPtr node_api, std::shared_ptr<aleth::FilterAPI> filter_api,
+      StateAPIPtr state_api, PendingBlockPtr pending_block, std::shared_ptr<FinalChain> final_chain,
+      SyncingFn syncing_fn)
+      : dev::rpc::Eth(std::move(node_api), filter_api, std::move(state_api), std::move(pending_block), final_chain,
+                      std::move(syncing_fn)),
+        logs_limits_(logs_limits),
+        filter_api_(std::move(filter_api)),
+        final_chain_(std::move(final_chain)) {}
+
+  std::string eth_newFilter(Json::Value const& json) override;
+  Json::Value eth_getFilterLogs(std::string const& filter_id) override;
+  Json::Value eth_getLogs(Json::Value const& json) override;
+
+ private:
+  // Throws a JSON-RPC invalid params error if the query exceeds the limits
+  Json::Value logs(LogsQuery const& query) const;
+
+  EthLogsLimits const logs_limits_;
+
+  // Base class has a FilterAPI of its own, the extended one is needed for the block ranges of logs filters
+  std::shared_ptr<aleth::FilterAPI> const filter_api_;
+  std::shared_ptr<FinalChain> const final_chain_;
+};
+
+}  // namespace taraxa::aleth
@@ -1,5 +1,11 @@
 #include "filter_api.hpp"
 
+#include <libweb3jsonrpc/JsonHelper.h>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
 #include "util/util.hpp"
 
 namespace taraxa::aleth {
@@ -9,25 +15,189 @@ using namespace eth;
 using namespace util;
 
 struct FilterAPIImpl : virtual FilterAPI {
-  optional<LogFilter> getLogFilter(FilterID id) const override { return std::nullopt; }
+  using Clock = chrono::steady_clock;
+
+  enum class FilterType { block, pending_transactions, logs };
+
+  struct Filter {
+    FilterType type;
+    optional<LogsQuery> logs_query;
+    // Changes since the last poll, ready to be consumed
+    deque<Json::Value> changes;
+    Clock::time_point last_access;
+  };
+
+  FilterAPIConfig const config;
+  mutable mutex mu;
+  mutable unordered_map<FilterID, Filter> filters;
+  uint64_t last_filter_id = 0;
+  h256 last_blk_hash;
+  BlockNumber last_blk_n = 0;
+
+  explicit FilterAPIImpl(FilterAPIConfig const& config) : config(config) {}
+
+  optional<LogFilter> getLogFilter(FilterID id) const override {
+    if (auto query = getLogsQuery(id)) {
+      return query->filter;
+    }
+    return nullopt;
+  }
+
+  optional<LogsQuery> getLogsQuery(FilterID id) const override {
+    lock_guard l(mu);
+    if (auto it = filters.find(id); it != filters.end()) {
+      it->second.last_access = Clock::now();
+      return it->second.logs_query;
+    }
+    return nullopt;
+  }
 
-  FilterID newBlockFilter() override { return 0; }
+  FilterID newBlockFilter() override { return install(FilterType::block, nullopt); }
 
-  FilterID newPendingTransactionFilter() override { return 0; }
+  FilterID newPendingTransactionFilter() override { return install(FilterType::pending_transactions, nullopt); }
 
-  FilterID newLogFilter(LogFilter const& _filter) override { return 0; }
+  FilterID newLogFilter(LogFilter const& _filter) override { return install(FilterType::logs, LogsQuery{_filter}); }
 
-  bool uninstallFilter(FilterID id) override { return false; }
+  FilterID newLogFilter(LogsQuery const& query) override { return install(FilterType::logs, query); }
 
-  void poll(FilterID id, Consumer const& consumer) override {}
+  bool uninstallFilter(FilterID id) override {
+    lock_guard l(mu);
+    return filters.erase(id);
+  }
 
-  void note_block(h256 const& blk_hash) override {}
+  void poll(FilterID id, Consumer const& consumer) override {
+    deque<Json::Value> changes;
+    {
+      lock_guard l(mu);
+      auto it = filters.find(id);
+      if (it == filters.end()) {
+        return;
+      }
+      it->second.last_access = Clock::now();
+      swap(changes, it->second.changes);
+    }
+    for (auto const& c : changes) {
+      consumer(c);
+    }
+  }
 
-  void note_pending_transactions(RangeView<h256> const& trx_hashes) override {}
+  void note_block(h256 const& blk_hash, BlockNumber blk_n) override {
+    lock_guard l(mu);
+    expire();
+    last_blk_hash = blk_hash;
+    last_blk_n = blk_n;
+    auto const blk_hash_json = toJS(blk_hash);
+    forEachFilter(FilterType::block, [&](auto& f) { addChange(f, blk_hash_json); });
+  }
 
-  void note_receipts(RangeView<TransactionReceipt> const& receipts) override {}
+  void note_pending_transactions(RangeView<h256> const& trx_hashes) override {
+    lock_guard l(mu);
+    forEachFilter(FilterType::pending_transactions, [&](auto& f) {
+      trx_hashes.for_each([&](auto const& h) { addChange(f, toJS(h)); });
+    });
+  }
+
+  void note_receipts(RangeView<h256> const& trx_hashes, RangeView<TransactionReceipt> const& receipts) override {
+    h256s hashes;
+    hashes.reserve(trx_hashes.size);
+    trx_hashes.for_each([&](auto const& h) { hashes.push_back(h); });
+    lock_guard l(mu);
+    forEachFilter(FilterType::logs, [&](auto& f) {
+      receipts.for_each([&](auto const& r, auto i) {
+        auto const matched = f.logs_query->filter.matches(r);
+        for (unsigned j = 0; j < matched.size(); ++j) {
+          addChange(f, toJson(LocalisedLogEntry(matched[j], last_blk_hash, last_blk_n, hashes[i], i, j)));
+        }
+      });
+    });
+  }
+
+  FilterID install(FilterType type, optional<LogsQuery> logs_query) {
+    lock_guard l(mu);
+    expire();
+    if (!filters.empty() && filters.size() >= config.max_filters) {
+      auto lru = filters.begin();
+      for (auto it = filters.begin(); it != filters.end(); ++it) {
+        if (it->second.last_access < lru->second.last_access) {
+          lru = it;
+        }
+      }
+      filters.erase(lru);
+    }
+    FilterID id(++last_filter_id);
+    filters.emplace(id, Filter{type, move(logs_query), {}, Clock::now()});
+    return id;
+  }
+
+  // Following methods must be called with the mutex locked
+
+  void expire() {
+    auto const deadline = Clock::now() - config.idle_timeout;
+    for (auto it = filters.begin(); it != filters.end();) {
+      if (it->second.last_access < deadline) {
+        it = filters.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  template <typename F>
+  void forEachFilter(FilterType type, F&& f) {
+    for (auto& [_, filter] : filters) {
+      if (filter.type == type) {
+        f(filter);
+      }
+    }
+  }
+
+  void addChange(Filter& f, Json::Value change) const {
+    if (f.changes.size() >= config.max_changes) {
+      f.changes.pop_front();
+    }
+    f.changes.push_back(move(change));
+  }
 };
 
-unique_ptr<FilterAPI> NewFilterAPI() { return u_ptr(new FilterAPIImpl); }
+LogsQuery LogsQuery::fromJson(Json::Value const& json) {
+  LogsQuery ret;
+  auto const blk_n = [](Json::Value const& v) -> optional<BlockNumber> {
+    if (v.isNull()) {
+      return nullopt;
+    }
+    auto const& s = v.asString();
+    if (s == "earliest") {
+      return 0;
+    }
+    if (s == "latest" || s == "pending") {
+      return nullopt;
+    }
+    return static_cast<BlockNumber>(jsToInt(s));
+  };
+  ret.from = blk_n(json["fromBlock"]);
+  ret.to = blk_n(json["toBlock"]);
+  auto const& address = json["address"];
+  if (address.isString()) {
+    ret.filter.address(Address(address.asString()));
+  } else {
+    for (auto const& a : address) {
+      ret.filter.address(Address(a.asString()));
+    }
+  }
+  auto const& topics = json["topics"];
+  for (unsigned i = 0; i < topics.size(); ++i) {
+    // null matches any topic, an array matches any of its topics
+    if (topics[i].isString()) {
+      ret.filter.topic(i, h256(topics[i].asString()));
+    } else {
+      for (auto const& t : topics[i]) {
+        ret.filter.topic(i, h256(t.asString()));
+      }
+    }
+  }
+  return ret;
+}
+
+unique_ptr<FilterAPI> NewFilterAPI(FilterAPIConfig const& config) { return u_ptr(new FilterAPIImpl(config)); }
 
 }  // namespace taraxa::aleth
@@ -2,17 +2,42 @@
 
 #include <libweb3jsonrpc/Eth.h>
 
+#include <chrono>
+#include <optional>
+
 #include "../util/range_view.hpp"
 
 namespace taraxa::aleth {
 
+// Logs filter of eth_getLogs/eth_newFilter with its block range, not set bounds mean the latest block at query time
+struct LogsQuery {
+  dev::eth::LogFilter filter;
+  std::optional<dev::eth::BlockNumber> from, to;
+
+  static LogsQuery fromJson(Json::Value const& json);
+};
+
 struct FilterAPI : virtual dev::rpc::Eth::FilterAPI {
   virtual ~FilterAPI() {}
-  virtual void note_block(dev::h256 const& blk_hash) = 0;
+  using dev::rpc::Eth::FilterAPI::newLogFilter;
+  virtual FilterID newLogFilter(LogsQuery const& query) = 0;
+  virtual std::optional<LogsQuery> getLogsQuery(FilterID id) const = 0;
+  virtual void note_block(dev::h256 const& blk_hash, dev::eth::BlockNumber blk_n) = 0;
   virtual void note_pending_transactions(util::RangeView<dev::h256> const& trx_hashes) = 0;
-  virtual void note_receipts(util::RangeView<dev::eth::TransactionReceipt> const& receipts) = 0;
+  // Receipts of the last noted block, trx_hashes are hashes of their transactions
+  virtual void note_receipts(util::RangeView<dev::h256> const& trx_hashes,
+                             util::RangeView<dev::eth::TransactionReceipt> const& receipts) = 0;
+};
+
+struct FilterAPIConfig {
+  // Installed filters limit, the least recently polled filter is uninstalled when a new one doesn't fit
+  size_t max_filters = 1000;
+  // Filters which have not been polled for this long are uninstalled
+  std::chrono::seconds idle_timeout = std::chrono::minutes(5);
+  // Changes kept per filter between polls, the oldest ones are dropped
+  size_t max_changes = 10000;
 };
 
-std::unique_ptr<FilterAPI> NewFilterAPI();
+std::unique_ptr<FilterAPI> NewFilterAPI(FilterAPIConfig const& config = {});
 
 }  // namespace taraxa::aleth
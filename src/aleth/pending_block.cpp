@@ -1,8 +1,8 @@
 #include "pending_block.hpp"
 
+#include <map>
 #include <shared_mutex>
-
-#include "transaction_manager/transaction.hpp"
+#include <unordered_map>
 
 namespace taraxa::aleth {
 using namespace dev;
@@ -10,52 +10,73 @@ using namespace eth;
 using namespace std;
 using namespace util;
 
-// TODO better performance, cache
 // TODO better consistency with the last block
 struct PendingBlockImpl : PendingBlock {
+  // Newly pending hashes are persisted once this many are accumulated, or with the next advance() batch
+  static constexpr size_t c_persist_batch_size = 256;
+
   BlockHeader block_header;
   shared_ptr<DbStorage> db;
   mutable shared_mutex mu;
 
+  // Ordered by hash, same order as the pending_transactions column
+  map<h256, eth::Transaction> trxs;
+  unordered_map<Address, uint64_t> trxs_count_per_sender;
+  h256s not_persisted;
+  mutable shared_mutex trxs_mu;
+
+  ~PendingBlockImpl() {
+    unique_lock l(trxs_mu);
+    if (!not_persisted.empty()) {
+      auto batch = db->createWriteBatch();
+      persist(batch);
+      db->commitWriteBatch(batch);
+    }
+  }
+
   BlockDetails details() const override {
     shared_lock l(mu);
     return {block_header.number(), 0, block_header.parentHash(), 0};
   }
 
-  uint64_t transactionsCount() const override { return transactionHashes().size(); }
+  uint64_t transactionsCount() const override {
+    shared_lock l(trxs_mu);
+    return trxs.size();
+  }
 
   uint64_t transactionsCount(Address const& from) const override {
-    uint64_t ret = 0;
-    for (auto const& trx : transactions()) {
-      if (trx.from() == from) {
-        ++ret;
-      }
+    shared_lock l(trxs_mu);
+    if (auto it = trxs_count_per_sender.find(from); it != trxs_count_per_sender.end()) {
+      return it->second;
     }
-    return ret;
+    return 0;
   }
 
   Transactions transactions() const override {
+    shared_lock l(trxs_mu);
     Transactions ret;
-    for (auto const& h : transactionHashes()) {
-      auto trx_rlp = db->getTransactionRaw(h);
-      if (!trx_rlp.empty()) {
-        ret.emplace_back(trx_rlp, CheckTransaction::None);
-      }
+    ret.reserve(trxs.size());
+    for (auto const& [_, trx] : trxs) {
+      ret.push_back(trx);
     }
     return ret;
   }
 
   optional<eth::Transaction> transaction(unsigned index) const override {
-    auto trxs = transactions();
-    return index < trxs.size() ? optional(trxs[index]) : nullopt;
+    shared_lock l(trxs_mu);
+    if (index >= trxs.size()) {
+      return nullopt;
+    }
+    return next(trxs.begin(), index)->second;
   }
 
   h256s transactionHashes() const override {
+    shared_lock l(trxs_mu);
     h256s ret;
-    db->forEach(DbStorage::Columns::pending_transactions, [&](auto const& k, auto const& _) {
-      ret.emplace_back(k.data(), h256::FromBinary);
-      return true;
-    });
+    ret.reserve(trxs.size());
+    for (auto const& [h, _] : trxs) {
+      ret.push_back(h);
+    }
     return ret;
   }
 
@@ -64,25 +85,74 @@ struct PendingBlockImpl : PendingBlock {
     return block_header;
   }
 
-  void add_transactions(RangeView<h256> const& pending_trx_hashes) override {
-    pending_trx_hashes.for_each([&, this](auto const& h) {
-      db->insert(DbStorage::Columns::pending_transactions, DbStorage::toSlice(h.ref()), "_");
+  void add_transactions(RangeView<Transaction> const& pending_trxs) override {
+    unique_lock l(trxs_mu);
+    pending_trxs.for_each([&, this](auto const& trx) {
+      // Sender is already known (recovered during verification), it's not recovered again here
+      eth::Transaction eth_trx(*trx.rlp(), CheckTransaction::None);
+      eth_trx.forceSender(trx.getSender());
+      if (insert(trx.getHash(), move(eth_trx))) {
+        not_persisted.push_back(trx.getHash());
+      }
     });
+    if (not_persisted.size() >= c_persist_batch_size) {
+      // Committed under the lock, otherwise advance() could delete an executed hash in between and its delete could be
+      // committed first, this put would then bring the executed transaction back as pending after a restart
+      auto batch = db->createWriteBatch();
+      persist(batch);
+      db->commitWriteBatch(batch);
+    }
   }
 
   void advance(DbStorage::BatchPtr batch, h256 const& curr_block_hash,
                RangeView<h256> const& executed_trx_hashes) override {
-    unique_lock l(mu);
-    BlockHeaderFields header_fields;
-    header_fields.m_number = block_header.number() + 1;
-    header_fields.m_parentHash = curr_block_hash;
-    header_fields.m_author = block_header.author();
-    header_fields.m_timestamp = dev::utcTime();
-    block_header = BlockHeader(header_fields);
+    {
+      unique_lock l(mu);
+      BlockHeaderFields header_fields;
+      header_fields.m_number = block_header.number() + 1;
+      header_fields.m_parentHash = curr_block_hash;
+      header_fields.m_author = block_header.author();
+      header_fields.m_timestamp = dev::utcTime();
+      block_header = BlockHeader(header_fields);
+    }
+    unique_lock l(trxs_mu);
+    // Puts go first so that deletes of the executed transactions in the same batch take precedence
+    persist(batch);
     executed_trx_hashes.for_each([&, this](auto const& h) {
+      if (auto it = trxs.find(h); it != trxs.end()) {
+        if (auto count_it = trxs_count_per_sender.find(it->second.from()); --count_it->second == 0) {
+          trxs_count_per_sender.erase(count_it);
+        }
+        trxs.erase(it);
+      }
       db->batch_delete(batch, DbStorage::Columns::pending_transactions, DbStorage::toSlice(h.ref()));
     });
   }
+
+  bool insert(h256 const& h, eth::Transaction&& trx) {
+    auto [it, inserted] = trxs.emplace(h, move(trx));
+    if (inserted) {
+      ++trxs_count_per_sender[it->second.from()];
+    }
+    return inserted;
+  }
+
+  void persist(DbStorage::BatchPtr const& batch) {
+    for (auto const& h : not_persisted) {
+      db->batch_put(batch, DbStorage::Columns::pending_transactions, DbStorage::toSlice(h.ref()), "_");
+    }
+    not_persisted.clear();
+  }
+
+  void load() {
+    db->forEach(DbStorage::Columns::pending_transactions, [&, this](auto const& k, auto const& _) {
+      h256 h(k.data(), h256::FromBinary);
+      if (auto trx_rlp = db->getTransactionRaw(h); !trx_rlp.empty()) {
+        insert(h, eth::Transaction(trx_rlp, CheckTransaction::None));
+      }
+      return true;
+    });
+  }
 };
 
 unique_ptr<PendingBlock> NewPendingBlock(uint64_t number, addr_t const& author, h256 const& curr_block_hash,
@@ -95,6 +165,7 @@ unique_ptr<PendingBlock> NewPendingBlock(uint64_t number, addr_t const& author,
   header_fields.m_timestamp = dev::utcTime();
   ret->block_header = {header_fields};
   ret->db = db;
+  ret->load();
   return ret;
 }
 
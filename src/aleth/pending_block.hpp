@@ -3,13 +3,16 @@
 #include <libweb3jsonrpc/Eth.h>
 
 #include "storage/db_storage.hpp"
+#include "transaction_manager/transaction.hpp"
 #include "util/range_view.hpp"
 
 namespace taraxa::aleth {
 
+// Pending transactions are served from memory (indexed by hash and by sender), the pending_transactions column is
+// only written in batches and read once on startup
 struct PendingBlock : virtual dev::rpc::Eth::PendingBlock {
   virtual ~PendingBlock() {}
-  virtual void add_transactions(util::RangeView<dev::h256> const& pending_trx_hashes) = 0;
+  virtual void add_transactions(util::RangeView<Transaction> const& pending_trxs) = 0;
   virtual void advance(DbStorage::BatchPtr batch, dev::h256 const& curr_block_hash,
                        util::RangeView<dev::h256> const& executed_trx_hashes) = 0;
 };
@@ -2,6 +2,8 @@
 
 #include <libdevcore/CommonJS.h>
 
+#include "log_index.hpp"
+
 namespace taraxa::final_chain {
 
 auto map_transactions(Transactions const& trxs) {
@@ -17,7 +19,7 @@ struct FinalChainImpl : virtual FinalChain, virtual ChainDBImpl {
   shared_ptr<aleth::Database> blk_db;
   shared_ptr<aleth::Database> ext_db;
   StateAPI state_api;
-  TransactionReceipts receipts_buf;
+  LogIndex log_index;
 
   FinalChainImpl(shared_ptr<DbStorage> db,
                  Config const& config,     //
@@ -28,15 +30,11 @@ struct FinalChainImpl : virtual FinalChain, virtual ChainDBImpl {
         blk_db(move(blk_db)),
         ext_db(move(ext_db)),
         state_api([this](auto n) { return ChainDBImpl::hashFromNumber(n); },  //
-                  config.state,
-                  {
-                      1500,
-                      4,
-                  },
+                  config.state, opts.state_api,
                   {
                       (db->stateDbStoragePath()).string(),
-                  }) {
-    receipts_buf.reserve(opts.state_api.ExpectedMaxTrxPerBlock);
+                  }),
+        log_index(db) {
     auto last_blk = ChainDBImpl::get_last_block();
     auto state_desc = state_api.get_last_committed_state_descriptor();
     if (!last_blk) {
@@ -92,7 +90,7 @@ struct FinalChainImpl : virtual FinalChain, virtual ChainDBImpl {
   AdvanceResult advance(DbStorage::BatchPtr batch, Address const& author, uint64_t timestamp,
                         Transactions const& transactions) override {
     constexpr auto gas_limit = std::numeric_limits<uint64_t>::max();
-    auto const& state_transition_result = state_api.transition_state(
+    auto& state_transition_result = state_api.transition_state(
         {
             author,
             gas_limit,
@@ -101,26 +99,51 @@ struct FinalChainImpl : virtual FinalChain, virtual ChainDBImpl {
         },
         map_transactions(transactions),  //
         {});
-    receipts_buf.clear();
-    receipts_buf.reserve(state_transition_result.ExecutionResults.size());
+    auto receipts = make_shared<TransactionReceipts>();
+    receipts->reserve(state_transition_result.ExecutionResults.size());
     gas_t cumulative_gas_used = 0;
-    for (auto const& r : state_transition_result.ExecutionResults) {
-      LogEntries logs;
+    LogEntries logs;
+    for (auto& r : state_transition_result.ExecutionResults) {
+      // Decoded topics and data are not needed anymore, so they are moved
+      logs.clear();
       logs.reserve(r.Logs.size());
-      for (auto const& l : r.Logs) {
-        logs.emplace_back(l.Address, l.Topics, l.Data);
+      for (auto& l : r.Logs) {
+        logs.emplace_back(l.Address, move(l.Topics), move(l.Data));
       }
-      receipts_buf.emplace_back(r.CodeErr.empty() && r.ConsensusErr.empty(), cumulative_gas_used += r.GasUsed,
-                                move(logs), r.NewContractAddr);
+      r.Logs.clear();
+      receipts->emplace_back(r.CodeErr.empty() && r.ConsensusErr.empty(), cumulative_gas_used += r.GasUsed, logs,
+                             r.NewContractAddr);
     }
     auto exit_stack = append_block_prepare(batch);
+    auto blk_header =
+        append_block(author, timestamp, gas_limit, state_transition_result.StateRoot, transactions, *receipts);
+    log_index.add(batch, blk_header.number(), *receipts);
     return {
-        append_block(author, timestamp, gas_limit, state_transition_result.StateRoot, transactions, receipts_buf),
-        receipts_buf,
+        move(blk_header),
+        move(receipts),
         state_transition_result,
     };
   }
 
+  LocalisedLogEntries logs(LogFilter const& filter, BlockNumber from, BlockNumber to,
+                           size_t max_count = 0) const override {
+    LocalisedLogEntries ret;
+    for (auto blk_n : log_index.blocks(filter, from, to)) {
+      if (max_count && ret.size() > max_count) {
+        break;
+      }
+      auto const blk_hash = ChainDBImpl::hashFromNumber(blk_n);
+      auto const trx_hashes = ChainDBImpl::transactionHashes(blk_hash);
+      for (unsigned i = 0; i < trx_hashes.size(); ++i) {
+        auto const matched = filter.matches(ChainDBImpl::transactionReceipt(trx_hashes[i]));
+        for (unsigned j = 0; j < matched.size(); ++j) {
+          ret.emplace_back(matched[j], blk_hash, blk_n, trx_hashes[i], i, j);
+        }
+      }
+    }
+    return ret;
+  }
+
   void advance_confirm() override {
     state_api.transition_state_commit();
     refresh_last_block();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libethereum/ChainDBImpl.h>
+#include <libethereum/LogFilter.h>
 
 #include "aleth/database.hpp"
 #include "common/types.hpp"
@@ -25,20 +26,28 @@ struct FinalChain : virtual ChainDB {
   };
 
   struct Opts {
-    state_api::Opts state_api;
+    // Sizes the receipts buffer and EVM side allocations of a block, and the number of main trie levels whose full
+    // nodes are kept in memory
+    state_api::Opts state_api{1500, 4};
   };
 
   virtual ~FinalChain() {}
 
   struct AdvanceResult {
     BlockHeader new_header;
-    TransactionReceipts const& receipts;
+    // Shared with the consumers of the new block, e.g. the filter API
+    shared_ptr<TransactionReceipts const> receipts;
+    // Logs are moved from it into the receipts
     state_api::StateTransitionResult const& state_transition_result;
   };
   virtual AdvanceResult advance(DbStorage::BatchPtr batch, Address const& author, uint64_t timestamp,
                                 Transactions const& transactions) = 0;
   virtual shared_ptr<BlockHeader> get_last_block() const = 0;
   virtual void advance_confirm() = 0;
+  // Logs of blocks in [from, to] matching the filter, blocks which can't contain such logs are skipped using the index.
+  // Stops once more than max_count logs are found if it's not 0, so the result size tells whether there are more
+  virtual LocalisedLogEntries logs(LogFilter const& filter, BlockNumber from, BlockNumber to,
+                                   size_t max_count = 0) const = 0;
   virtual void create_snapshot(uint64_t const& period) = 0;
   virtual optional<state_api::Account> get_account(addr_t const& addr, optional<BlockNumber> blk_n = nullopt) const = 0;
   virtual u256 get_account_storage(addr_t const& addr, u256 const& key,
@@ -0,0 +1,122 @@
+#include "log_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+
+namespace taraxa::final_chain {
+
+using Columns = DbStorage::Columns;
+
+LogIndex::LogIndex(shared_ptr<DbStorage> db) : db_(move(db)) {}
+
+void LogIndex::add(DbStorage::BatchPtr const& batch, BlockNumber blk_n, TransactionReceipts const& receipts) const {
+  LogBloom blk_bloom;
+  set<pair<Address, h256>> postings;
+  for (auto const& r : receipts) {
+    if (r.log().empty()) {
+      continue;
+    }
+    blk_bloom |= r.bloom();
+    for (auto const& l : r.log()) {
+      postings.emplace(l.address, h256());
+      if (!l.topics.empty()) {
+        postings.emplace(l.address, l.topics[0]);
+        postings.emplace(Address(), l.topics[0]);
+      }
+    }
+  }
+  if (postings.empty()) {
+    return;
+  }
+  db_->batch_put(*batch, Columns::final_chain_log_blooms, blkNumberKey(blk_n), blk_bloom);
+  static string const empty_val;
+  for (auto const& [address, topic0] : postings) {
+    db_->batch_put(*batch, Columns::final_chain_log_index, postingKey(address, topic0, blk_n), empty_val);
+  }
+}
+
+vector<BlockNumber> LogIndex::blocks(LogFilter const& filter, BlockNumber from, BlockNumber to) const {
+  vector<BlockNumber> candidates;
+  if (from > to) {
+    return candidates;
+  }
+  auto const& addresses = filter.addresses();
+  auto const& topics0 = filter.topics()[0];
+  if (addresses.empty() && topics0.empty()) {
+    // Nothing to look postings up by, every block with logs is a candidate
+    db_->forEach(Columns::final_chain_log_blooms, DbStorage::toSlice(blkNumberKey(from)), [&](auto const& k, auto&&) {
+      auto const blk_n = fromBigEndian<BlockNumber>(DbStorage::toBytesConstRef(k));
+      if (blk_n > to) {
+        return false;
+      }
+      candidates.push_back(blk_n);
+      return true;
+    });
+  } else {
+    auto const any_addresses = addresses.empty() ? AddressHash{Address()} : addresses;
+    auto const any_topics0 = topics0.empty() ? h256Hash{h256()} : topics0;
+    for (auto const& address : any_addresses) {
+      for (auto const& topic0 : any_topics0) {
+        collectPostings(address, topic0, from, to, candidates);
+      }
+    }
+    sort(candidates.begin(), candidates.end());
+    candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+  if (candidates.empty()) {
+    return candidates;
+  }
+  // The rest of the filter (other topics) is checked against block blooms
+  vector<bytes> bloom_keys;
+  bloom_keys.reserve(candidates.size());
+  for (auto blk_n : candidates) {
+    bloom_keys.push_back(blkNumberKey(blk_n));
+  }
+  auto const blooms = DbStorage::MultiGetQuery(db_, bloom_keys.size())
+                          .append(Columns::final_chain_log_blooms, bloom_keys, false)
+                          .execute();
+  vector<BlockNumber> ret;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (blooms[i].size() == LogBloom::size &&
+        filter.matches(LogBloom(bytesConstRef(reinterpret_cast<byte const*>(blooms[i].data()), LogBloom::size)))) {
+      ret.push_back(candidates[i]);
+    }
+  }
+  return ret;
+}
+
+bytes LogIndex::blkNumberKey(BlockNumber blk_n) {
+  bytes ret(sizeof(uint64_t));
+  toBigEndian(uint64_t(blk_n), ret);
+  return ret;
+}
+
+bytes LogIndex::postingKey(Address const& address, h256 const& topic0, BlockNumber blk_n) {
+  bytes ret;
+  ret.reserve(Address::size + h256::size + sizeof(uint64_t));
+  ret.insert(ret.end(), address.begin(), address.end());
+  ret.insert(ret.end(), topic0.begin(), topic0.end());
+  auto const blk_n_key = blkNumberKey(blk_n);
+  ret.insert(ret.end(), blk_n_key.begin(), blk_n_key.end());
+  return ret;
+}
+
+void LogIndex::collectPostings(Address const& address, h256 const& topic0, BlockNumber from, BlockNumber to,
+                               vector<BlockNumber>& ret) const {
+  auto const start = postingKey(address, topic0, from);
+  auto const prefix_size = Address::size + h256::size;
+  db_->forEach(Columns::final_chain_log_index, DbStorage::toSlice(start), [&](auto const& k, auto&&) {
+    if (k.size() != start.size() || memcmp(k.data(), start.data(), prefix_size) != 0) {
+      return false;
+    }
+    auto const blk_n = fromBigEndian<BlockNumber>(DbStorage::toBytesConstRef(k).cropped(prefix_size));
+    if (blk_n > to) {
+      return false;
+    }
+    ret.push_back(blk_n);
+    return true;
+  });
+}
+
+}  // namespace taraxa::final_chain
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <libethcore/Common.h>
+#include <libethereum/LogFilter.h>
+#include <libethereum/TransactionReceipt.h>
+
+#include <vector>
+
+#include "storage/db_storage.hpp"
+
+namespace taraxa::final_chain {
+using namespace std;
+using namespace dev;
+using namespace eth;
+
+/**
+ * Index of the final chain logs, lets log range queries skip blocks which can't contain matching logs instead of
+ * decoding receipts of every block.
+ *
+ * For every block with logs the bloom of all its logs is stored, plus a posting per distinct (address, topic0) pair of
+ * its logs. Postings keys are address + topic0 + big endian block number, so blocks of a pair are found by a single
+ * seek and come in ascending order. Zero address/topic0 of a posting means any, so filters specifying only addresses
+ * or only first topics are served as well. Entries are written in the batch of the block.
+ */
+class LogIndex {
+ public:
+  explicit LogIndex(shared_ptr<DbStorage> db);
+
+  void add(DbStorage::BatchPtr const& batch, BlockNumber blk_n, TransactionReceipts const& receipts) const;
+  // Ascending numbers of blocks in [from, to] whose bloom matches the filter
+  vector<BlockNumber> blocks(LogFilter const& filter, BlockNumber from, BlockNumber to) const;
+
+ private:
+  static bytes blkNumberKey(BlockNumber blk_n);
+  static bytes postingKey(Address const& address, h256 const& topic0, BlockNumber blk_n);
+
+  // Candidate blocks of a posting key prefix (address + topic0)
+  void collectPostings(Address const& address, h256 const& topic0, BlockNumber from, BlockNumber to,
+                       vector<BlockNumber>& ret) const;
+
+  shared_ptr<DbStorage> const db_;
+};
+
+}  // namespace taraxa::final_chain
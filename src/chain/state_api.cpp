@@ -164,9 +164,9 @@ StateDescriptor StateAPI::get_last_committed_state_descriptor() const {
   return ret;
 }
 
-StateTransitionResult const& StateAPI::transition_state(EVMBlock const& block,  //
-                                                        RangeView<EVMTransaction> const& transactions,
-                                                        RangeView<UncleBlock> const& uncles) {
+StateTransitionResult& StateAPI::transition_state(EVMBlock const& block,  //
+                                                  RangeView<EVMTransaction> const& transactions,
+                                                  RangeView<UncleBlock> const& uncles) {
   result_buf_transition_state.ExecutionResults.clear();
   rlp_enc_transition_state.clear();
   c_method_args_rlp<StateTransitionResult, from_rlp, taraxa_evm_state_api_transition_state>(
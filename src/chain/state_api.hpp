@@ -242,9 +242,10 @@ class StateAPI {
   ExecutionResult dry_run_transaction(BlockNumber blk_num, EVMBlock const& blk, EVMTransaction const& trx,
                                       optional<ExecutionOptions> const& opts = nullopt) const;
   StateDescriptor get_last_committed_state_descriptor() const;
-  StateTransitionResult const& transition_state(EVMBlock const& block,
-                                                RangeView<EVMTransaction> const& transactions,  //
-                                                RangeView<UncleBlock> const& uncles = {});
+  // The result is a buffer reused by the next call, so its parts can be moved out of it
+  StateTransitionResult& transition_state(EVMBlock const& block,
+                                          RangeView<EVMTransaction> const& transactions,  //
+                                          RangeView<UncleBlock> const& uncles = {});
   void transition_state_commit();
   void create_snapshot(uint64_t const& period);
   // DPOS
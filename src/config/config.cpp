@@ -2,6 +2,7 @@
 
 #include <json/json.h>
 
+#include <algorithm>
 #include <fstream>
 
 namespace taraxa {
@@ -103,13 +104,26 @@ FullNodeConfig::FullNodeConfig(Json::Value const &string_or_object,
   network.network_udp_port = getConfigDataAsUInt(root, {"network_udp_port"});
   network.network_simulated_delay = getConfigDataAsUInt(root, {"network_simulated_delay"});
   network.network_transaction_interval = getConfigDataAsUInt(root, {"network_transaction_interval"});
+  network.network_transaction_max_packet_size =
+      getConfigDataAsUInt(root, {"network_transaction_max_packet_size"}, true, 128 * 1024);
   network.network_min_dag_block_broadcast = getConfigDataAsUInt(root, {"network_min_dag_block_broadcast"}, true, 5);
   network.network_max_dag_block_broadcast = getConfigDataAsUInt(root, {"network_max_dag_block_broadcast"}, true, 20);
   network.network_bandwidth = getConfigDataAsUInt(root, {"network_bandwidth"});
   network.network_ideal_peer_count = getConfigDataAsUInt(root, {"network_ideal_peer_count"});
   network.network_max_peer_count = getConfigDataAsUInt(root, {"network_max_peer_count"});
   network.network_sync_level_size = getConfigDataAsUInt(root, {"network_sync_level_size"});
+  network.network_pbft_sync_cache_size =
+      getConfigDataAsUInt(root, {"network_pbft_sync_cache_size"}, true, network.network_pbft_sync_cache_size);
   network.network_encrypted = getConfigDataAsUInt(root, {"network_encrypted"}) != 0;
+  if (auto fp_rate = getConfigData(root, {"network_known_items_false_positive_rate"}, true); !fp_rate.isNull()) {
+    network.network_known_items_false_positive_rate = fp_rate.asDouble();
+  }
+  network.network_known_items_max_age =
+      getConfigDataAsUInt(root, {"network_known_items_max_age"}, true, network.network_known_items_max_age);
+  if (auto metrics_file = getConfigData(root, {"network_metrics_file"}, true); !metrics_file.isNull()) {
+    network.network_metrics_file = metrics_file.asString();
+  }
+  network.network_metrics_dump_interval = getConfigDataAsUInt(root, {"network_metrics_dump_interval"}, true, 10000);
   for (auto &item : root["network_boot_nodes"]) {
     NodeConfig node;
     node.id = getConfigDataAsString(item, {"id"});
@@ -140,6 +154,61 @@ FullNodeConfig::FullNodeConfig(Json::Value const &string_or_object,
     if (auto threads_num = getConfigData(rpc_config, {"threads_num"}, true); !threads_num.isNull()) {
       rpc->threads_num = threads_num.asUInt();
     }
+
+    // http keep-alive connections
+    if (auto idle_timeout = getConfigData(rpc_config, {"http_idle_timeout_ms"}, true); !idle_timeout.isNull()) {
+      rpc->http_idle_timeout_ms = idle_timeout.asUInt();
+    }
+    if (auto max_connections = getConfigData(rpc_config, {"http_max_connections"}, true); !max_connections.isNull()) {
+      rpc->http_max_connections = max_connections.asUInt();
+    }
+    if (auto batch_threads_num = getConfigData(rpc_config, {"batch_threads_num"}, true); !batch_threads_num.isNull()) {
+      rpc->batch_threads_num = batch_threads_num.asUInt();
+    }
+
+    // websocket sessions outbound queues
+    if (auto max_queue_size = getConfigData(rpc_config, {"ws_max_queue_size"}, true); !max_queue_size.isNull()) {
+      rpc->ws_max_queue_size = max_queue_size.asUInt();
+    }
+    if (auto max_queued_bytes = getConfigData(rpc_config, {"ws_max_queued_bytes"}, true); !max_queued_bytes.isNull()) {
+      rpc->ws_max_queued_bytes = max_queued_bytes.asUInt64();
+    }
+    if (auto overflow_policy = getConfigData(rpc_config, {"ws_overflow_policy"}, true); !overflow_policy.isNull()) {
+      rpc->ws_overflow_policy = overflow_policy.asString();
+    }
+
+    // logs queries
+    if (auto max_block_range = getConfigData(rpc_config, {"logs_max_block_range"}, true); !max_block_range.isNull()) {
+      rpc->logs_max_block_range = max_block_range.asUInt64();
+    }
+    if (auto max_results = getConfigData(rpc_config, {"logs_max_results"}, true); !max_results.isNull()) {
+      rpc->logs_max_results = max_results.asUInt();
+    }
+  }
+
+  if (auto db_config = getConfigData(root, {"db"}, true); !db_config.isNull()) {
+    if (auto block_cache_size = getConfigData(db_config, {"block_cache_size"}, true); !block_cache_size.isNull()) {
+      db.block_cache_size = block_cache_size.asUInt64();
+    }
+    db.max_background_jobs = getConfigDataAsUInt(db_config, {"max_background_jobs"}, true, db.max_background_jobs);
+    // Profiles and column assignments given in the config replace the default ones with the same name
+    auto const &profiles = db_config["profiles"];
+    for (auto const &name : profiles.getMemberNames()) {
+      auto const &profile = profiles[name];
+      auto &opts = db.profiles[name] = DbColumnOptions();
+      opts.bloom_bits_per_key = getConfigDataAsUInt(profile, {"bloom_bits_per_key"}, true);
+      if (auto hash_index = getConfigData(profile, {"data_block_hash_index"}, true); !hash_index.isNull()) {
+        opts.data_block_hash_index = hash_index.asBool();
+      }
+      if (auto write_buffer_size = getConfigData(profile, {"write_buffer_size"}, true); !write_buffer_size.isNull()) {
+        opts.write_buffer_size = write_buffer_size.asUInt64();
+      }
+      opts.max_write_buffer_number = getConfigDataAsUInt(profile, {"max_write_buffer_number"}, true);
+    }
+    auto const &columns = db_config["columns"];
+    for (auto const &name : columns.getMemberNames()) {
+      db.columns[name] = columns[name].asString();
+    }
   }
 
   {  // for test experiments
@@ -172,6 +241,9 @@ FullNodeConfig::FullNodeConfig(Json::Value const &string_or_object,
         logger::Config logging;
         logging.name = getConfigDataAsString(item, {"name"});
         logging.verbosity = logger::stringToVerbosity(getConfigDataAsString(item, {"verbosity"}));
+        if (auto async = getConfigData(item, {"async"}, true); !async.isNull()) {
+          logging.async = async.asBool();
+        }
         for (auto &ch : item["channels"]) {
           std::pair<std::string, uint16_t> channel;
           channel.first = getConfigDataAsString(ch, {"name"});
@@ -218,9 +290,14 @@ FullNodeConfig::FullNodeConfig(Json::Value const &string_or_object,
   }
 
   network.network_id = chain.chain_id;
-  // TODO configurable
-  opts_final_chain.state_api.ExpectedMaxTrxPerBlock = 1000;
-  opts_final_chain.state_api.MainTrieFullNodeLevelsToCache = 4;
+
+  if (auto const &state_api_config = root["state_api"]; !state_api_config.isNull()) {
+    auto &opts = opts_final_chain.state_api;
+    opts.ExpectedMaxTrxPerBlock = getConfigDataAsUInt(state_api_config, {"expected_max_trx_per_block"}, true,
+                                                      opts.ExpectedMaxTrxPerBlock);
+    opts.MainTrieFullNodeLevelsToCache = getConfigDataAsUInt(state_api_config, {"main_trie_full_node_levels_to_cache"},
+                                                             true, opts.MainTrieFullNodeLevelsToCache);
+  }
 }
 
 bool FullNodeConfig::validate() {
@@ -238,6 +315,55 @@ bool FullNodeConfig::validate() {
       cerr << "rpc::threads_num must be in range (0, " << max_threads_num << ">";
       return false;
     }
+
+    if (rpc->http_idle_timeout_ms == 0 || rpc->http_max_connections == 0) {
+      cerr << "rpc::http_idle_timeout_ms and rpc::http_max_connections must be greater than 0";
+      return false;
+    }
+
+    if (rpc->batch_threads_num == 0 || rpc->batch_threads_num > 200) {
+      cerr << "rpc::batch_threads_num must be in range (0, 200]";
+      return false;
+    }
+
+    if (rpc->ws_max_queue_size == 0 || rpc->ws_max_queued_bytes == 0) {
+      cerr << "rpc::ws_max_queue_size and rpc::ws_max_queued_bytes must be greater than 0";
+      return false;
+    }
+
+    if (rpc->ws_overflow_policy != "drop_oldest" && rpc->ws_overflow_policy != "coalesce" &&
+        rpc->ws_overflow_policy != "disconnect") {
+      cerr << "rpc::ws_overflow_policy must be one of drop_oldest, coalesce, disconnect";
+      return false;
+    }
+  }
+
+  if (network.network_known_items_false_positive_rate <= 0 || network.network_known_items_false_positive_rate >= 1) {
+    cerr << "network_known_items_false_positive_rate must be in range (0, 1)";
+    return false;
+  }
+
+  for (auto const &[column, profile] : db.columns) {
+    if (std::none_of(DbStorage::Columns::all.begin(), DbStorage::Columns::all.end(),
+                     [&](auto const &col) { return col.name == column; })) {
+      cerr << "db::columns contains unknown column " << column;
+      return false;
+    }
+    if (!db.profiles.count(profile)) {
+      cerr << "db::columns::" << column << " refers to unknown profile " << profile;
+      return false;
+    }
+  }
+
+  if (!network.network_metrics_file.empty() && network.network_metrics_dump_interval == 0) {
+    cerr << "network_metrics_dump_interval must be greater than 0";
+    return false;
+  }
+
+  // A main trie path is at most 64 nibbles long
+  if (opts_final_chain.state_api.MainTrieFullNodeLevelsToCache > 64) {
+    cerr << "state_api::main_trie_full_node_levels_to_cache must be in range [0, 64]";
+    return false;
   }
 
   // TODO: add validation of other config values
@@ -263,10 +389,16 @@ std::ostream &operator<<(std::ostream &strm, NetworkConfig const &conf) {
   strm << "  network_udp_port: " << conf.network_udp_port << std::endl;
   strm << "  network_simulated_delay: " << conf.network_simulated_delay << std::endl;
   strm << "  network_transaction_interval: " << conf.network_transaction_interval << std::endl;
+  strm << "  network_transaction_max_packet_size: " << conf.network_transaction_max_packet_size << std::endl;
   strm << "  network_bandwidth: " << conf.network_bandwidth << std::endl;
   strm << "  network_ideal_peer_count: " << conf.network_ideal_peer_count << std::endl;
   strm << "  network_max_peer_count: " << conf.network_max_peer_count << std::endl;
   strm << "  network_sync_level_size: " << conf.network_sync_level_size << std::endl;
+  strm << "  network_pbft_sync_cache_size: " << conf.network_pbft_sync_cache_size << std::endl;
+  strm << "  network_known_items_false_positive_rate: " << conf.network_known_items_false_positive_rate << std::endl;
+  strm << "  network_known_items_max_age: " << conf.network_known_items_max_age << std::endl;
+  strm << "  network_metrics_file: " << conf.network_metrics_file << std::endl;
+  strm << "  network_metrics_dump_interval: " << conf.network_metrics_dump_interval << std::endl;
   strm << "  network_id: " << conf.network_id << std::endl;
 
   strm << "  --> boot nodes  ... " << std::endl;
@@ -18,6 +18,24 @@ struct RpcConfig {
 
   // Number of threads dedicated to the rpc calls processing, default = 5
   uint16_t threads_num{5};
+
+  // Idle keep-alive http connections are closed after this timeout, default = 30s
+  uint32_t http_idle_timeout_ms{30000};
+  // Maximum number of concurrently open http connections, further ones are rejected, default = 1000
+  uint32_t http_max_connections{1000};
+  // Number of threads executing elements of json-rpc batch requests concurrently, default = 4
+  uint16_t batch_threads_num{4};
+
+  // Outbound queue of a websocket session is limited to ws_max_queue_size messages, when it's full the overflow policy
+  // (drop_oldest, coalesce or disconnect) is applied. All the sessions together queue at most ws_max_queued_bytes
+  uint32_t ws_max_queue_size{1000};
+  uint64_t ws_max_queued_bytes{64 * 1024 * 1024};
+  std::string ws_overflow_policy{"drop_oldest"};
+
+  // eth_getLogs and eth_getFilterLogs fail for ranges of more than logs_max_block_range blocks and when they match
+  // more than logs_max_results logs, 0 means no limit
+  uint64_t logs_max_block_range{10000};
+  uint32_t logs_max_results{10000};
 };
 
 struct NodeConfig {
@@ -39,9 +57,20 @@ struct NetworkConfig {
   uint16_t network_ideal_peer_count = 0;
   uint16_t network_max_peer_count = 0;
   uint16_t network_transaction_interval = 0;
+  // Queued transactions are sent to a peer once their size reaches this limit or on network_transaction_interval
+  uint32_t network_transaction_max_packet_size = 128 * 1024;
   uint16_t network_min_dag_block_broadcast = 0;
   uint16_t network_max_dag_block_broadcast = 0;
   uint16_t network_sync_level_size = 0;
+  // Memory budget of the cache of encoded PBFT sync responses, 0 disables the cache
+  uint32_t network_pbft_sync_cache_size = 32 * 1024 * 1024;  // bytes
+  // False positive rate of the per peer known blocks/transactions/votes filters
+  double network_known_items_false_positive_rate = 0.001;
+  // Time window of the per peer known items filters, 0 makes them rotate by item count only
+  uint32_t network_known_items_max_age = 600000;  // ms
+  // Prometheus text dump of network metrics is periodically written to this file, disabled when empty
+  std::string network_metrics_file;
+  uint32_t network_metrics_dump_interval = 10000;  // ms
   uint64_t network_id;
   bool network_encrypted = 0;
   bool network_performance_log = 0;
@@ -80,6 +109,7 @@ struct FullNodeConfig {
   std::string node_secret;
   vrf_wrapper::vrf_sk_t vrf_secret;
   fs::path db_path;
+  DbConfig db;
   NetworkConfig network;
   optional<RpcConfig> rpc;
   TestParamsConfig test_params;
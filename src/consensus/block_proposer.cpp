@@ -1,5 +1,7 @@
 #include "block_proposer.hpp"
 
+#include <pthread.h>
+
 #include <cmath>
 
 #include "dag/dag.hpp"
@@ -12,6 +14,23 @@ namespace taraxa {
 using namespace vdf_sortition;
 std::atomic<uint64_t> BlockProposer::num_proposed_blocks = 0;
 
+SortitionPropose::SortitionPropose(vdf_sortition::VdfConfig const& vdf_config, addr_t node_addr,
+                                   std::shared_ptr<DagManager> dag_mgr, std::shared_ptr<TransactionManager> trx_mgr)
+    : vdf_config_(vdf_config), dag_mgr_(dag_mgr), trx_mgr_(trx_mgr) {
+  LOG_OBJECTS_CREATE("PR_MDL");
+  LOG(log_nf_) << "Set sorition DAG block proposal" << vdf_config_;
+  frontier_sub_ = dag_mgr_->event_frontier_changed.sub([this](auto const& frontier) { onFrontierChanged(frontier); });
+}
+
+SortitionPropose::~SortitionPropose() { dag_mgr_->event_frontier_changed.unsub(frontier_sub_); }
+
+void SortitionPropose::onFrontierChanged(DagFrontier const& frontier) {
+  std::unique_lock lock(vdf_pivot_mu_);
+  if (!vdf_pivot_.isZero() && vdf_pivot_ != frontier.pivot) {
+    vdf_cancelled_ = true;
+  }
+}
+
 bool SortitionPropose::propose() {
   auto proposer = proposer_.lock();
   if (!proposer) {
@@ -19,7 +38,9 @@ bool SortitionPropose::propose() {
     return false;
   }
 
-  if (trx_mgr_->getTransactionQueueSize().second == 0) {
+  stale_retry_ = false;
+  // Transactions of other shards can't be proposed, so don't compute the VDF for them
+  if (!proposer->hasShardedTrxs()) {
     return false;
   }
 
@@ -35,10 +56,12 @@ bool SortitionPropose::propose() {
   // get sortition
   vdf_sortition::VdfSortition vdf(vdf_config_, node_addr_, vrf_sk_, getRlpBytes(propose_level));
   if (vdf.isStale(vdf_config_)) {
+    // Tries are counted in proposal delays, so keep retrying even if nothing changes meanwhile
     if (propose_level == last_propose_level_ && num_tries_ < max_num_tries_) {
       LOG(log_dg_) << "Will not propose DAG block. Get difficulty at stale, last propose level " << last_propose_level_
                    << ", has tried " << num_tries_ << " times.";
       num_tries_++;
+      stale_retry_ = true;
       return false;
     } else if (propose_level != last_propose_level_) {
       LOG(log_dg_) << "Will not propose DAG block, will reset number of tries. "
@@ -46,10 +69,29 @@ bool SortitionPropose::propose() {
                    << last_propose_level_ << ", current propose level " << propose_level;
       last_propose_level_ = propose_level;
       num_tries_ = 0;
+      stale_retry_ = true;
       return false;
     }
   }
-  vdf.computeVdfSolution(vdf_config_, frontier.pivot.asBytes());
+  stale_retry_ = false;
+  {
+    std::unique_lock lock(vdf_pivot_mu_);
+    vdf_pivot_ = frontier.pivot;
+    vdf_cancelled_ = false;
+  }
+  // The frontier could have moved before the pivot was set
+  if (dag_mgr_->getDagFrontier().pivot != frontier.pivot) {
+    vdf_cancelled_ = true;
+  }
+  bool const computed = vdf.computeVdfSolution(vdf_config_, frontier.pivot.asBytes(), vdf_cancelled_);
+  {
+    std::unique_lock lock(vdf_pivot_mu_);
+    vdf_pivot_ = blk_hash_t();
+  }
+  if (!computed) {
+    LOG(log_dg_) << "VDF computation on pivot " << frontier.pivot << " cancelled, the pivot has changed";
+    return false;
+  }
   if (vdf.isStale(vdf_config_)) {
     DagFrontier latestFrontier = dag_mgr_->getDagFrontier();
     if (latestFrontier.pivot != frontier.pivot) return false;
@@ -87,14 +129,19 @@ void BlockProposer::start() {
   propose_model_->setProposer(getShared(), node_addr_, node_sk_, vrf_sk_);
   // reset number of proposed blocks
   BlockProposer::num_proposed_blocks = 0;
+  frontier_sub_ = dag_mgr_->event_frontier_changed.sub([this](auto const &) { notifyChange(); });
+  trx_sub_ = trx_mgr_->event_transaction_verified.sub([this](auto const &) { notifyChange(); });
+  if (auto const &capability = network_->getTaraxaCapability()) {
+    syncing_sub_ = capability->event_syncing_changed.sub([this](auto const &) { notifyChange(); });
+  }
   proposer_worker_ = std::make_shared<std::thread>([this]() {
     while (!stopped_) {
       // Blocks are not proposed if we are behind the network and still syncing
-      if (!network_->isSynced()) {
+      if (network_->isSynced() && (propose_model_->propose() || propose_model_->retryPending())) {
+        sleepUnlessStopped(std::chrono::milliseconds(min_proposal_delay));
         continue;
       }
-      propose_model_->propose();
-      thisThreadSleepForMilliSeconds(min_proposal_delay);
+      waitForChange(std::chrono::milliseconds(max_proposal_delay));
     }
   });
 }
@@ -103,9 +150,47 @@ void BlockProposer::stop() {
   if (bool b = false; !stopped_.compare_exchange_strong(b, !b)) {
     return;
   }
+  dag_mgr_->event_frontier_changed.unsub(frontier_sub_);
+  trx_mgr_->event_transaction_verified.unsub(trx_sub_);
+  if (auto const &capability = network_ ? network_->getTaraxaCapability() : nullptr) {
+    capability->event_syncing_changed.unsub(syncing_sub_);
+  }
+  {
+    std::unique_lock lock(changes_mu_);
+    changes_cv_.notify_all();
+  }
   proposer_worker_->join();
 }
 
+void BlockProposer::notifyChange() {
+  if (has_changes_.exchange(true)) {
+    return;
+  }
+  std::unique_lock lock(changes_mu_);
+  changes_cv_.notify_one();
+}
+
+void BlockProposer::waitForChange(std::chrono::milliseconds timeout) {
+  std::unique_lock lock(changes_mu_);
+  changes_cv_.wait_for(lock, timeout, [this] { return stopped_ || has_changes_; });
+  has_changes_ = false;
+}
+
+void BlockProposer::sleepUnlessStopped(std::chrono::milliseconds duration) {
+  std::unique_lock lock(changes_mu_);
+  changes_cv_.wait_for(lock, duration, [this] { return stopped_.load(); });
+}
+
+std::chrono::nanoseconds BlockProposer::getWorkerCpuTime() const {
+  clockid_t clock_id;
+  timespec ts;
+  if (!proposer_worker_ || pthread_getcpuclockid(proposer_worker_->native_handle(), &clock_id) != 0 ||
+      clock_gettime(clock_id, &ts) != 0) {
+    return {};
+  }
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
 bool BlockProposer::getLatestPivotAndTips(blk_hash_t& pivot, vec_blk_t& tips) {
   std::string pivot_string;
   std::vector<std::string> tips_string;
@@ -127,20 +212,8 @@ bool BlockProposer::getLatestPivotAndTips(blk_hash_t& pivot, vec_blk_t& tips) {
 }
 
 bool BlockProposer::getShardedTrxs(uint total_shard, uint my_shard, vec_trx_t& sharded_trxs) {
-  vec_trx_t to_be_packed_trx;
-  trx_mgr_->packTrxs(to_be_packed_trx, bp_config_.transaction_limit);
-
-  if (to_be_packed_trx.empty()) {
-    LOG(log_tr_) << "Skip block proposer, zero unpacked transactions ..." << std::endl;
-    return false;
-  }
-  sharded_trxs.clear();
-  for (auto const& t : to_be_packed_trx) {
-    auto shard = std::stoull(t.toString().substr(0, 10), NULL, 16);
-    if (shard % total_trx_shards_ == my_trx_shard_) {
-      sharded_trxs.emplace_back(t);
-    }
-  }
+  // Transactions of other shards are left in the queue
+  trx_mgr_->packTrxs(sharded_trxs, bp_config_.transaction_limit, shardFilter(total_shard, my_shard));
   if (sharded_trxs.empty()) {
     LOG(log_tr_) << "Skip block proposer, zero sharded transactions ..." << std::endl;
     return false;
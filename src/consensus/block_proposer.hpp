@@ -1,6 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <random>
 #include <thread>
 #include <vector>
@@ -26,6 +30,9 @@ class ProposeModelFace {
  public:
   virtual ~ProposeModelFace() {}
   virtual bool propose() = 0;
+  // True if the last propose() failed only for the moment and should be retried after the minimal delay, even without
+  // any change of the DAG, transactions or syncing state
+  virtual bool retryPending() const { return false; }
   void setProposer(std::shared_ptr<BlockProposer> proposer, addr_t node_addr, secret_t const& sk,
                    vrf_sk_t const& vrf_sk) {
     proposer_ = proposer;
@@ -44,16 +51,21 @@ class ProposeModelFace {
 class SortitionPropose : public ProposeModelFace {
  public:
   SortitionPropose(vdf_sortition::VdfConfig const& vdf_config, addr_t node_addr, std::shared_ptr<DagManager> dag_mgr,
-                   std::shared_ptr<TransactionManager> trx_mgr)
-      : vdf_config_(vdf_config), dag_mgr_(dag_mgr), trx_mgr_(trx_mgr) {
-    LOG_OBJECTS_CREATE("PR_MDL");
-    LOG(log_nf_) << "Set sorition DAG block proposal" << vdf_config_;
-  }
-  ~SortitionPropose() {}
+                   std::shared_ptr<TransactionManager> trx_mgr);
+  ~SortitionPropose();
   bool propose() override;
+  bool retryPending() const override { return stale_retry_; }
 
  private:
+  // Cancels the VDF computation if the pivot it is computed for is no longer the frontier pivot
+  void onFrontierChanged(DagFrontier const& frontier);
+
   vdf_sortition::VdfConfig vdf_config_;
+  bool stale_retry_ = false;
+  std::mutex vdf_pivot_mu_;
+  blk_hash_t vdf_pivot_;
+  std::atomic_bool vdf_cancelled_ = false;
+  uint64_t frontier_sub_ = 0;
   int num_tries_ = 0;
   const int max_num_tries_ = 20;  // Wait 2000(ms)
   level_t last_propose_level_ = 0;
@@ -66,6 +78,9 @@ class SortitionPropose : public ProposeModelFace {
 /**
  * Single thread
  * Block proproser request for unpacked transaction
+ *
+ * The worker sleeps until the DAG frontier, the verified transactions or the syncing state change (or
+ * max_proposal_delay passes) instead of polling, proposals are still at least min_proposal_delay apart.
  */
 class BlockProposer : public std::enable_shared_from_this<BlockProposer> {
  public:
@@ -98,21 +113,47 @@ class BlockProposer : public std::enable_shared_from_this<BlockProposer> {
   void setNetwork(std::shared_ptr<Network> network) { network_ = network; }
   void proposeBlock(DagBlock& blk);
   bool getShardedTrxs(vec_trx_t& sharded_trx) { return getShardedTrxs(total_trx_shards_, my_trx_shard_, sharded_trx); }
+  // Whether there are verified transactions of the own shard, cheap check before the VDF is computed
+  bool hasShardedTrxs() const { return trx_mgr_->hasVerifiedTrx(shardFilter(total_trx_shards_, my_trx_shard_)); }
+  // Big endian value of the first 5 bytes of the hash modulo total_shards
+  static uint16_t getTrxShard(trx_hash_t const& hash, uint16_t total_shards) {
+    uint64_t key = 0;
+    for (size_t i = 0; i < 5; ++i) {
+      key = (key << 8) | hash[i];
+    }
+    return key % total_shards;
+  }
   bool getLatestPivotAndTips(blk_hash_t& pivot, vec_blk_t& tips);
   level_t getProposeLevel(blk_hash_t const& pivot, vec_blk_t const& tips);
   blk_hash_t getProposeAnchor() const;
   bool validDposProposer(level_t const propose_level);
   // debug
   static uint64_t getNumProposedBlocks() { return BlockProposer::num_proposed_blocks; }
+  // CPU time consumed by the worker thread so far
+  std::chrono::nanoseconds getWorkerCpuTime() const;
   friend ProposeModelFace;
 
  private:
   bool getShardedTrxs(uint total_shard, uint my_shard, vec_trx_t& sharded_trx);
+  static std::function<bool(trx_hash_t const&)> shardFilter(uint total_shard, uint my_shard) {
+    return [total_shard, my_shard](auto const& hash) { return getTrxShard(hash, total_shard) == my_shard; };
+  }
   addr_t getFullNodeAddress() const;
+  void notifyChange();
+  // Both return early if stopped
+  void waitForChange(std::chrono::milliseconds timeout);
+  void sleepUnlessStopped(std::chrono::milliseconds duration);
 
   inline static const uint16_t min_proposal_delay = 100;
+  inline static const uint16_t max_proposal_delay = 1000;
   static std::atomic<uint64_t> num_proposed_blocks;
   std::atomic<bool> stopped_ = true;
+  std::mutex changes_mu_;
+  std::condition_variable changes_cv_;
+  std::atomic<bool> has_changes_ = false;
+  uint64_t frontier_sub_ = 0;
+  uint64_t trx_sub_ = 0;
+  uint64_t syncing_sub_ = 0;
   BlockProposerConfig bp_config_;
   uint16_t total_trx_shards_;
   uint16_t my_trx_shard_;
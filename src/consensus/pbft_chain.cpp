@@ -101,7 +101,9 @@ bytes PbftBlock::rlp(bool include_sig) const {
 }
 
 std::ostream& operator<<(std::ostream& strm, PbftBlock const& pbft_blk) {
-  strm << pbft_blk.getJsonStr();
+  strm << "[PbftBlock] hash: " << pbft_blk.getBlockHash() << ", prev block hash: " << pbft_blk.getPrevBlockHash()
+       << ", dag block hash as pivot: " << pbft_blk.getPivotDagBlockHash() << ", period: " << pbft_blk.getPeriod()
+       << ", timestamp: " << pbft_blk.getTimestamp() << ", beneficiary: " << pbft_blk.getBeneficiary();
   return strm;
 }
 
@@ -145,16 +147,16 @@ PbftChain::PbftChain(std::string const& dag_genesis_hash, addr_t node_addr, std:
       db_(db) {
   LOG_OBJECTS_CREATE("PBFT_CHAIN");
   // Get PBFT head from DB
-  auto pbft_head_str = db_->getPbftHead(head_hash_);
-  if (pbft_head_str.empty()) {
+  auto pbft_head_raw = db_->getPbftHead(head_hash_);
+  if (pbft_head_raw.empty()) {
     // Store PBFT HEAD to db
-    auto head_json_str = getJsonStr();
-    db_->savePbftHead(head_hash_, head_json_str);
-    LOG(log_nf_) << "Initialize PBFT chain head " << head_json_str;
-  } else {
+    db_->savePbftHead(head_hash_, getRlp());
+    LOG(log_nf_) << "Initialize PBFT chain head " << getHeadStr();
+  } else if (pbft_head_raw.front() == '{') {
+    // Legacy styled JSON head record, upgrade it to the binary one
     Json::Value doc;
     Json::Reader reader;
-    reader.parse(pbft_head_str, doc);
+    reader.parse(std::string(pbft_head_raw.begin(), pbft_head_raw.end()), doc);
     {
       uniqueLock_ lock(chain_head_access_);
       head_hash_ = blk_hash_t(doc["head_hash"].asString());
@@ -164,7 +166,24 @@ PbftChain::PbftChain(std::string const& dag_genesis_hash, addr_t node_addr, std:
     }
     auto dag_genesis_hash_db = blk_hash_t(doc["dag_genesis_hash"].asString());
     assert(dag_genesis_hash_ == dag_genesis_hash_db);
-    LOG(log_nf_) << "Retrieve from DB, PBFT chain head " << getJsonStr();
+    db_->savePbftHead(head_hash_, getRlp());
+    LOG(log_nf_) << "Upgraded PBFT chain head record from JSON " << getHeadStr();
+  } else {
+    dev::RLP const rlp(pbft_head_raw);
+    auto const version = rlp[0].toInt<uint8_t>();
+    if (version != c_head_record_version) {
+      throw std::runtime_error("Unsupported PBFT chain head record version " + std::to_string(version));
+    }
+    {
+      uniqueLock_ lock(chain_head_access_);
+      head_hash_ = rlp[1].toHash<blk_hash_t>();
+      size_ = rlp[3].toInt<uint64_t>();
+      executed_size_ = rlp[4].toInt<uint64_t>();
+      last_pbft_block_hash_ = rlp[5].toHash<blk_hash_t>();
+    }
+    auto dag_genesis_hash_db = rlp[2].toHash<blk_hash_t>();
+    assert(dag_genesis_hash_ == dag_genesis_hash_db);
+    LOG(log_nf_) << "Retrieve from DB, PBFT chain head " << getHeadStr();
   }
 }
 
@@ -388,6 +407,13 @@ std::string PbftChain::getJsonStr() const {
   return json.toStyledString();
 }
 
+bytes PbftChain::getRlp() const {
+  RLPStream s(6);
+  sharedLock_ lock(chain_head_access_);
+  s << c_head_record_version << head_hash_ << dag_genesis_hash_ << size_ << executed_size_ << last_pbft_block_hash_;
+  return s.out();
+}
+
 std::ostream& operator<<(std::ostream& strm, PbftChain const& pbft_chain) {
   strm << pbft_chain.getHeadStr();
   return strm;
@@ -411,6 +437,18 @@ size_t PbftChain::pbftSyncedQueueSize() const {
   return pbft_synced_queue_.size();
 }
 
+bool PbftChain::waitPbftSyncedQueueSize(size_t max_size, std::atomic<bool> const& stopped) const {
+  sharedLock_ lock(sync_access_);
+  // Nothing notifies on stop, so the flag is checked periodically
+  while (pbft_synced_queue_.size() > max_size) {
+    if (stopped) {
+      return false;
+    }
+    synced_queue_cv_.wait_for(lock, boost::chrono::milliseconds(100));
+  }
+  return true;
+}
+
 bool PbftChain::pbftSyncedQueueEmpty() const {
   sharedLock_ lock(sync_access_);
   return pbft_synced_queue_.empty();
@@ -428,8 +466,11 @@ PbftBlockCert PbftChain::pbftSyncedQueueBack() const {
 
 void PbftChain::pbftSyncedQueuePopFront() {
   pbftSyncedSetErase_();
-  uniqueLock_ lock(sync_access_);
-  pbft_synced_queue_.pop_front();
+  {
+    uniqueLock_ lock(sync_access_);
+    pbft_synced_queue_.pop_front();
+  }
+  synced_queue_cv_.notify_all();
 }
 
 void PbftChain::setSyncedPbftBlockIntoQueue(PbftBlockCert const& pbft_block_and_votes) {
@@ -442,9 +483,12 @@ void PbftChain::setSyncedPbftBlockIntoQueue(PbftBlockCert const& pbft_block_and_
 }
 
 void PbftChain::clearSyncedPbftBlocks() {
-  uniqueLock_ lock(sync_access_);
-  pbft_synced_queue_.clear();
-  pbft_synced_set_.clear();
+  {
+    uniqueLock_ lock(sync_access_);
+    pbft_synced_queue_.clear();
+    pbft_synced_set_.clear();
+  }
+  synced_queue_cv_.notify_all();
 }
 
 void PbftChain::pbftSyncedSetInsert_(blk_hash_t const& pbft_block_hash) {
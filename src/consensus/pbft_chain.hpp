@@ -7,7 +7,9 @@
 #include <libdevcrypto/Common.h>
 #include <libethcore/Common.h>
 
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -92,6 +94,8 @@ class PbftChain {
   std::vector<std::string> getPbftBlocksStr(size_t period, size_t count, bool hash) const;  // Remove
   std::string getHeadStr() const;
   std::string getJsonStr() const;
+  // Versioned binary head record persisted in DB
+  bytes getRlp() const;
 
   bool findPbftBlockInChain(blk_hash_t const& pbft_block_hash);
   bool findUnverifiedPbftBlock(blk_hash_t const& pbft_block_hash) const;
@@ -116,6 +120,8 @@ class PbftChain {
   void setSyncedPbftBlockIntoQueue(PbftBlockCert const& pbft_block_and_votes);
   void clearSyncedPbftBlocks();
   size_t pbftSyncedQueueSize() const;
+  // Blocks until the synced queue holds at most max_size blocks, returns false if stopped was set meanwhile
+  bool waitPbftSyncedQueueSize(size_t max_size, std::atomic<bool> const& stopped) const;
   bool isKnownPbftBlockForSyncing(blk_hash_t const& pbft_block_hash);
 
  private:
@@ -128,7 +134,13 @@ class PbftChain {
   using upgradableLock_ = boost::upgrade_lock<boost::shared_mutex>;
   using upgradeLock_ = boost::upgrade_to_unique_lock<boost::shared_mutex>;
 
+  // Head record versions: legacy styled JSON (no version), 1 - RLP list [version, head_hash, dag_genesis_hash, size,
+  // executed_size, last_pbft_block_hash]
+  static constexpr uint8_t c_head_record_version = 1;
+
   mutable boost::shared_mutex sync_access_;
+  // Notified when blocks leave the synced queue
+  mutable boost::condition_variable_any synced_queue_cv_;
   mutable boost::shared_mutex unverified_access_;
   mutable boost::shared_mutex chain_head_access_;
 
@@ -55,13 +55,13 @@ void PbftManager::start() {
   if (bool b = true; !stopped_.compare_exchange_strong(b, !b)) {
     return;
   }
-  std::vector<std::string> ghost;
-  dag_mgr_->getGhostPath(dag_genesis_, ghost);
-  while (ghost.empty()) {
+  auto ghost = dag_mgr_->getGhostPath(dag_genesis_);
+  while (ghost->empty()) {
     LOG(log_dg_) << "GHOST is empty. DAG initialization has not done. Sleep 100ms";
     thisThreadSleepForMilliSeconds(100);
+    ghost = dag_mgr_->getGhostPath(dag_genesis_);
   }
-  LOG(log_dg_) << "PBFT start at GHOST size " << ghost.size() << ", the last of DAG blocks is " << ghost.back();
+  LOG(log_dg_) << "PBFT start at GHOST size " << ghost->size() << ", the last of DAG blocks is " << ghost->back();
   daemon_ = std::make_unique<std::thread>([this]() { run(); });
   LOG(log_dg_) << "PBFT daemon initiated ...";
   if (RUN_COUNT_VOTES) {
@@ -77,7 +77,11 @@ void PbftManager::stop() {
   }
 
   if (RUN_COUNT_VOTES) {
-    monitor_stop_ = true;
+    {
+      std::unique_lock<std::mutex> lock(stop_mtx_);
+      monitor_stop_ = true;
+      stop_cv_.notify_all();
+    }
     monitor_votes_->join();
     LOG(log_nf_test_) << "PBFT monitor vote logs terminated";
   }
@@ -904,17 +908,17 @@ std::pair<blk_hash_t, bool> PbftManager::softVotedBlockForRound_(std::vector<tar
 
 std::pair<blk_hash_t, bool> PbftManager::proposeMyPbftBlock_() {
   LOG(log_dg_) << "Into propose PBFT block";
-  std::string last_period_dag_anchor_block_hash;
+  blk_hash_t last_period_dag_anchor_block_hash;
   if (pbft_chain_last_block_hash_) {
     last_period_dag_anchor_block_hash =
-        pbft_chain_->getPbftBlockInChain(pbft_chain_last_block_hash_).getPivotDagBlockHash().toString();
+        pbft_chain_->getPbftBlockInChain(pbft_chain_last_block_hash_).getPivotDagBlockHash();
   } else {
     // First PBFT pivot block
     last_period_dag_anchor_block_hash = dag_genesis_;
   }
 
-  std::vector<std::string> ghost;
-  dag_mgr_->getGhostPath(last_period_dag_anchor_block_hash, ghost);
+  auto ghost_ptr = dag_mgr_->getGhostPath(last_period_dag_anchor_block_hash);
+  auto const &ghost = *ghost_ptr;
   LOG(log_dg_) << "GHOST size " << ghost.size();
   // Looks like ghost never empty, at lease include the last period dag anchor
   // block
@@ -936,11 +940,11 @@ std::pair<blk_hash_t, bool> PbftManager::proposeMyPbftBlock_() {
       }
       ghost_index += 1;
     }
-    dag_block_hash = blk_hash_t(ghost[ghost_index]);
+    dag_block_hash = ghost[ghost_index];
   } else {
-    dag_block_hash = blk_hash_t(ghost[DAG_BLOCKS_SIZE - 1]);
+    dag_block_hash = ghost[DAG_BLOCKS_SIZE - 1];
   }
-  if (dag_block_hash.toString() == dag_genesis_) {
+  if (dag_block_hash == dag_genesis_) {
     LOG(log_dg_) << "No new DAG blocks generated. DAG only has genesis " << dag_block_hash
                  << " PBFT propose NULL_BLOCK_HASH";
     return std::make_pair(NULL_BLOCK_HASH, true);
@@ -949,7 +953,7 @@ std::pair<blk_hash_t, bool> PbftManager::proposeMyPbftBlock_() {
   // dag blocks generated since last round. In that case PBFT proposer should
   // propose NULL BLOCK HASH as their value and not produce a new block. In
   // practice this should never happen
-  if (dag_block_hash.toString() == last_period_dag_anchor_block_hash) {
+  if (dag_block_hash == last_period_dag_anchor_block_hash) {
     LOG(log_dg_) << "Last period DAG anchor block hash " << dag_block_hash
                  << " No new DAG blocks generated, PBFT propose NULL_BLOCK_HASH";
     LOG(log_dg_) << "Ghost: " << ghost;
@@ -1231,7 +1235,7 @@ bool PbftManager::pushPbftBlock_(PbftBlockCert const &pbft_block_cert_votes) {
   // update PBFT chain size
   pbft_chain_->updatePbftChain(pbft_block_hash);
   // Update PBFT chain head block
-  db_->addPbftHeadToBatch(pbft_chain_->getHeadHash(), pbft_chain_->getJsonStr(), batch);
+  db_->addPbftHeadToBatch(pbft_chain_->getHeadHash(), pbft_chain_->getRlp(), batch);
   // Commit DB
   db_->commitWriteBatch(batch);
   LOG(log_nf_) << node_addr_ << " successful push unexecuted pbft block " << pbft_block_hash << " in period "
@@ -1260,29 +1264,13 @@ void PbftManager::updateTwoTPlusOneAndThreshold_() {
 }
 
 void PbftManager::countVotes_() {
-  auto round = getPbftRound();
   while (!monitor_stop_) {
-    std::vector<Vote> votes = vote_mgr_->getAllVotes();
-
-    size_t last_step_votes = 0;
-    size_t current_step_votes = 0;
-    for (auto const &v : votes) {
-      if (step_ == 1) {
-        if (v.getRound() == round - 1 && v.getStep() == last_step_) {
-          last_step_votes++;
-        } else if (v.getRound() == round && v.getStep() == step_) {
-          current_step_votes++;
-        }
-      } else {
-        if (v.getRound() == round) {
-          if (v.getStep() == step_ - 1) {
-            last_step_votes++;
-          } else if (v.getStep() == step_) {
-            current_step_votes++;
-          }
-        }
-      }
-    }
+    auto round = getPbftRound();
+    size_t step = step_;
+    // Counters are maintained by the vote manager, so votes are not copied here
+    size_t last_step_votes = step == 1 ? vote_mgr_->getVotesCount(round - 1, last_step_)
+                                       : vote_mgr_->getVotesCount(round, step - 1);
+    size_t current_step_votes = vote_mgr_->getVotesCount(round, step);
 
     auto now = std::chrono::system_clock::now();
     auto last_step_duration = now - last_step_clock_initial_datetime_;
@@ -1295,9 +1283,11 @@ void PbftManager::countVotes_() {
 
     LOG(log_nf_test_) << "Round " << round << " step " << last_step_ << " time " << elapsed_last_step_time_in_ms
                       << "(ms) has " << last_step_votes << " votes";
-    LOG(log_nf_test_) << "Round " << round << " step " << step_ << " time " << elapsed_current_step_time_in_ms
+    LOG(log_nf_test_) << "Round " << round << " step " << step << " time " << elapsed_current_step_time_in_ms
                       << "(ms) has " << current_step_votes << " votes";
-    thisThreadSleepForMilliSeconds(POLLING_INTERVAL_ms / 2);
+    std::unique_lock<std::mutex> lock(stop_mtx_);
+    stop_cv_.wait_for(lock, std::chrono::milliseconds(POLLING_INTERVAL_ms / 2),
+                      [this] { return monitor_stop_.load(); });
   }
 }
 
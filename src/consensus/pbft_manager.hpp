@@ -207,7 +207,7 @@ class PbftManager {
   // 2t+1 minimum number of votes for consensus
   size_t TWO_T_PLUS_ONE = 0;
 
-  std::string dag_genesis_;
+  blk_hash_t dag_genesis_;
 
   std::condition_variable stop_cv_;
   std::mutex stop_mtx_;
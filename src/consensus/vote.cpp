@@ -116,10 +116,12 @@ bool VoteManager::addVote(taraxa::Vote const& vote) {
       }
       upgradeLock_ locked(lock);
       unverified_votes_[pbft_round][hash] = vote;
+      ++votes_count_[pbft_round][vote.getStep()];
     } else {
       std::map<vote_hash_t, Vote> votes{std::make_pair(hash, vote)};
       upgradeLock_ locked(lock);
       unverified_votes_[pbft_round] = votes;
+      votes_count_[pbft_round] = {{vote.getStep(), 1}};
     }
   }
   LOG(log_dg_) << "Add vote " << hash << ", block hash " << vote.getBlockHash() << ", vote type " << vote.getType()
@@ -136,11 +138,13 @@ void VoteManager::cleanupVotes(uint64_t pbft_round) {
   while (it != unverified_votes_.end() && it->first < pbft_round) {
     it = unverified_votes_.erase(it);
   }
+  votes_count_.erase(votes_count_.begin(), votes_count_.lower_bound(pbft_round));
 }
 
 void VoteManager::clearUnverifiedVotesTable() {
   uniqueLock_ lock(access_);
   unverified_votes_.clear();
+  votes_count_.clear();
 }
 
 uint64_t VoteManager::getUnverifiedVotesSize() const {
@@ -260,6 +264,16 @@ std::vector<Vote> VoteManager::getAllVotes() {
   return votes;
 }
 
+size_t VoteManager::getVotesCount(uint64_t pbft_round, size_t pbft_step) const {
+  sharedLock_ lock(access_);
+  if (auto round_it = votes_count_.find(pbft_round); round_it != votes_count_.end()) {
+    if (auto step_it = round_it->second.find(pbft_step); step_it != round_it->second.end()) {
+      return step_it->second;
+    }
+  }
+  return 0;
+}
+
 bool VoteManager::pbftBlockHasEnoughValidCertVotes(PbftBlockCert const& pbft_block_and_votes,
                                                    size_t valid_sortition_players, size_t sortition_threshold,
                                                    size_t pbft_2t_plus_1) const {
@@ -5,6 +5,7 @@
 #include <deque>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 #include "common/types.hpp"
 #include "config/config.hpp"
@@ -156,6 +157,8 @@ class VoteManager {
                              std::function<bool(addr_t const&)> const& is_eligible);
   std::string getJsonStr(std::vector<Vote> const& votes);
   std::vector<Vote> getAllVotes();
+  // Number of unverified votes of the round and step, without copying them
+  size_t getVotesCount(uint64_t pbft_round, size_t pbft_step) const;
   bool pbftBlockHasEnoughValidCertVotes(PbftBlockCert const& pbft_block_and_votes, size_t valid_sortition_players,
                                         size_t sortition_threshold, size_t pbft_2t_plus_1) const;
 
@@ -167,6 +170,8 @@ class VoteManager {
 
   // <pbft_round, <vote_hash, vote>>
   std::map<uint64_t, std::map<vote_hash_t, Vote>> unverified_votes_;
+  // <pbft_round, <pbft_step, votes count>> of unverified_votes_, maintained along with it
+  std::map<uint64_t, std::unordered_map<size_t, size_t>> votes_count_;
 
   mutable boost::shared_mutex access_;
 
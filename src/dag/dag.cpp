@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "transaction_manager/transaction_manager.hpp"
+#include "util/flat_hash.hpp"
 
 namespace taraxa {
 
@@ -126,10 +127,10 @@ bool Dag::computeOrder(vertex_hash const &anchor, std::vector<vertex_hash> &orde
   }
   ordered_period_vertices.clear();
 
-  vertex_iter_t s, e;
   vertex_index_map_t index_map = boost::get(boost::vertex_index, graph_);  // from vertex_descriptor to hash
-  std::map<blk_hash_t, vertex_t> epfriend;                                 // this is unordered epoch
-  epfriend[blk_hash_t(index_map[target])] = target;
+  // Epoch blocks sorted by hash, so the traversal starts in deterministic order
+  std::vector<std::pair<blk_hash_t, vertex_t>> epfriend;
+  epfriend.emplace_back(index_map[target], target);
 
   // Step 1: collect all epoch blks that can reach anchor
   // Erase from recent_added_blks after mark epoch number if finialized
@@ -137,23 +138,27 @@ bool Dag::computeOrder(vertex_hash const &anchor, std::vector<vertex_hash> &orde
   for (auto &l : non_finalized_blks) {
     for (auto &blk : l.second) {
       auto v = graph_.vertex(blk);
-      if (reachable(v, target)) {
-        epfriend[blk_hash_t(index_map[v])] = v;
+      if (v != target && reachable(v, target)) {
+        epfriend.emplace_back(index_map[v], v);
       }
     }
   }
+  std::sort(epfriend.begin(), epfriend.end());
+  util::FlatHashSet<vertex_t> in_epoch(epfriend.size());
+  for (auto const &vp : epfriend) {
+    in_epoch.insert(vp.second);
+  }
   // Step2: compute topological order of epfriend
-  std::unordered_set<vertex_t> visited;
+  util::FlatHashSet<vertex_t> visited(epfriend.size());
   std::stack<std::pair<vertex_t, bool>> dfs;
   vertex_adj_iter_t adj_s, adj_e;
 
   for (auto const &vp : epfriend) {
     auto const &v = vp.second;
-    if (visited.count(v)) {
+    if (!visited.insert(v)) {
       continue;
     }
     dfs.push({v, false});
-    visited.insert(v);
     while (!dfs.empty()) {
       auto cur = dfs.top();
       dfs.pop();
@@ -165,14 +170,13 @@ bool Dag::computeOrder(vertex_hash const &anchor, std::vector<vertex_hash> &orde
       std::vector<std::pair<blk_hash_t, vertex_t>> neighbors;
       // iterate through neighbors
       for (std::tie(adj_s, adj_e) = adjacenct_vertices(cur.first, graph_); adj_s != adj_e; adj_s++) {
-        if (epfriend.find(blk_hash_t(index_map[*adj_s])) == epfriend.end()) {  // not in this epoch
+        if (!in_epoch.count(*adj_s)) {  // not in this epoch
           continue;
         }
-        if (visited.count(*adj_s)) {
+        if (!visited.insert(*adj_s)) {
           continue;
         }
         neighbors.emplace_back(std::make_pair(index_map[*adj_s], *adj_s));
-        visited.insert(*adj_s);
       }
       // make sure iterated nodes have deterministic order
       std::sort(neighbors.begin(), neighbors.end());
@@ -191,7 +195,7 @@ bool Dag::reachable(vertex_t const &from, vertex_t const &to) const {
   vertex_t current = from;
   vertex_t target = to;
   std::stack<vertex_t> st;
-  std::set<vertex_t> visited;
+  util::FlatHashSet<vertex_t> visited;
   st.push(current);
   visited.insert(current);
 
@@ -200,9 +204,8 @@ bool Dag::reachable(vertex_t const &from, vertex_t const &to) const {
     st.pop();
     vertex_adj_iter_t s, e;
     for (std::tie(s, e) = adjacenct_vertices(t, graph_); s != e; ++s) {
-      if (visited.count(*s)) continue;
       if (*s == target) return true;
-      visited.insert(*s);
+      if (!visited.insert(*s)) continue;
       st.push(*s);
     }
   }
@@ -243,13 +246,13 @@ void PivotTree::getGhostPath(vertex_hash const &vertex, std::vector<vertex_hash>
   std::reverse(post_order.begin(), post_order.end());
 
   // second step: compute weight based on step one
-  std::unordered_map<vertex_t, size_t> weight_map;
+  util::FlatHashMap<vertex_t, size_t> weight_map(post_order.size());
   for (auto const &n : post_order) {
     auto total_w = 0;
     // get childrens
     for (std::tie(s, e) = adjacenct_vertices(n, graph_); s != e; s++) {
-      if (weight_map.count(*s)) {  // bigger timestamp
-        total_w += weight_map[*s];
+      if (auto w = weight_map.find(*s)) {  // bigger timestamp
+        total_w += *w;
       }
     }
     weight_map[n] = total_w + 1;
@@ -264,8 +267,9 @@ void PivotTree::getGhostPath(vertex_hash const &vertex, std::vector<vertex_hash>
     vertex_t next;
 
     for (std::tie(s, e) = adjacenct_vertices(root, graph_); s != e; s++) {
-      if (!weight_map.count(*s)) continue;  // bigger timestamp
-      size_t w = weight_map[*s];
+      auto weight = weight_map.find(*s);
+      if (!weight) continue;  // bigger timestamp
+      size_t w = *weight;
       assert(w > 0);
       if (w > heavist) {
         heavist = w;
@@ -368,6 +372,7 @@ DagFrontier DagManager::getDagFrontier() {
 
 void DagManager::addDagBlock(DagBlock const &blk, bool finalized, bool save) {
   auto write_batch = db_->createWriteBatch();
+  DagFrontier frontier;
   {
     uLock lock(mutex_);
     if (save) {
@@ -395,9 +400,11 @@ void DagManager::addDagBlock(DagBlock const &blk, bool finalized, bool save) {
       frontier_.tips.emplace_back(blk_hash_t(t));
     }
     db_->commitWriteBatch(write_batch);
+    frontier = frontier_;
   }
   LOG(log_dg_) << " Update frontier after adding block " << blk.getHash() << "anchor " << anchor_
-               << " pivot = " << frontier_.pivot << " tips: " << frontier_.tips;
+               << " pivot = " << frontier.pivot << " tips: " << frontier.tips;
+  event_frontier_changed.pub(frontier);
 }
 
 void DagManager::drawGraph(std::string const &dotfile) const {
@@ -410,6 +417,7 @@ void DagManager::addToDag(std::string const &hash, std::string const &pivot, std
                           uint64_t level, const taraxa::DbStorage::BatchPtr &write_batch, bool finalized) {
   total_dag_->addVEEs(hash, pivot, tips);
   pivot_tree_->addVEEs(hash, pivot, {});
+  ++dag_version_;
   db_->addDagBlockStateToBatch(write_batch, blk_hash_t(hash), finalized);
   if (finalized) {
     finalized_blks_[level].push_back(hash);
@@ -450,9 +458,23 @@ void DagManager::collectTotalLeaves(std::vector<std::string> &leaves) const {
   sharedLock lock(mutex_);
   total_dag_->getLeaves(leaves);
 }
-void DagManager::getGhostPath(std::string const &source, std::vector<std::string> &ghost) const {
+std::shared_ptr<std::vector<blk_hash_t> const> DagManager::getGhostPath(blk_hash_t const &anchor) const {
   sharedLock lock(mutex_);
-  pivot_tree_->getGhostPath(source, ghost);
+  std::unique_lock cache_lock(ghost_path_cache_mu_);
+  if (ghost_path_cache_ && ghost_path_cache_anchor_ == anchor && ghost_path_cache_version_ == dag_version_) {
+    return ghost_path_cache_;
+  }
+  std::vector<std::string> ghost;
+  pivot_tree_->getGhostPath(anchor.toString(), ghost);
+  auto path = std::make_shared<std::vector<blk_hash_t>>();
+  path->reserve(ghost.size());
+  for (auto const &h : ghost) {
+    path->emplace_back(h);
+  }
+  ghost_path_cache_anchor_ = anchor;
+  ghost_path_cache_version_ = dag_version_;
+  ghost_path_cache_ = std::move(path);
+  return ghost_path_cache_;
 }
 
 void DagManager::getGhostPath(std::vector<std::string> &ghost) const {
@@ -507,10 +529,14 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, uint64_t period,
 
   std::vector<std::string> leaves;
   total_dag_->getLeaves(leaves);
-  std::set<std::string> leavesSet(leaves.begin(), leaves.end());
+  util::FlatHashSet<blk_hash_t> leavesSet(leaves.size());
+  for (auto const &leaf : leaves) {
+    leavesSet.insert(blk_hash_t(leaf));
+  }
 
   total_dag_->clear();
   pivot_tree_->clear();
+  ++dag_version_;
   auto finalized_blocks = finalized_blks_;
   auto non_finalized_blocks = non_finalized_blks_;
   finalized_blks_.clear();
@@ -532,7 +558,7 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, uint64_t period,
 
       // Do not remove from total dag if a block is a leaf -- THERE IS A CHANCE
       // THAT THIS MIGHT NOT BE POSSIBLE SO MAYBE AN ASSERT WOULD BE BETTER
-      if (leavesSet.count(blk) > 0) {
+      if (leavesSet.count(blk_hash_t(blk)) > 0) {
         addToDag(blk, pivot_hash.toString(), tips, block->getLevel(), write_batch, true);
       } else {
         db_->removeDagBlockStateToBatch(write_batch, blk_hash_t(blk));
@@ -556,7 +582,7 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, uint64_t period,
       new_anchor_found = true;
     }
 
-    if (leavesSet.count(blk) > 0 || blk == new_anchor.toString()) {
+    if (leavesSet.count(block) > 0 || block == new_anchor) {
       addToDag(blk, pivot_hash.toString(), tips, dag_block->getLevel(), write_batch, true);
       db_->addDagBlockStateToBatch(write_batch, blk_hash_t(blk), true);
     } else {
@@ -566,7 +592,7 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, uint64_t period,
   assert(new_anchor_found);
 
   // Add remaining blocks that are not finalized
-  std::set<blk_hash_t> dag_order_set(dag_order.begin(), dag_order.end());
+  util::FlatHashSet<blk_hash_t> dag_order_set(dag_order.begin(), dag_order.end());
   for (auto &v : non_finalized_blocks) {
     for (auto &blk : v.second) {
       if (dag_order_set.count(blk_hash_t(blk)) == 0) {
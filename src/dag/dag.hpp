@@ -26,6 +26,7 @@
 #include "dag_block.hpp"
 #include "storage/db_storage.hpp"
 #include "transaction_manager/transaction_manager.hpp"
+#include "util/simple_event.hpp"
 #include "util/util.hpp"
 namespace taraxa {
 
@@ -117,6 +118,9 @@ class FullNode;
 
 class DagManager : public std::enable_shared_from_this<DagManager> {
  public:
+  // Published with the new frontier after a block is added
+  util::SimpleEvent<DagFrontier> const event_frontier_changed{};
+
   using uLock = boost::unique_lock<boost::shared_mutex>;
   using sharedLock = boost::shared_lock<boost::shared_mutex>;
 
@@ -141,7 +145,8 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   bool getLatestPivotAndTips(std::string &pivot, std::vector<std::string> &tips) const;
   void collectTotalLeaves(std::vector<std::string> &leaves) const;
 
-  void getGhostPath(std::string const &source, std::vector<std::string> &ghost) const;
+  // GHOST path from the anchor, memoized until the DAG changes, so PBFT steps of a round share a single computation
+  std::shared_ptr<std::vector<blk_hash_t> const> getGhostPath(blk_hash_t const &anchor) const;
   void getGhostPath(std::vector<std::string> &ghost) const;  // get ghost path from last anchor
   // ----- Total graph
   void drawTotalGraph(std::string const &str) const;
@@ -191,6 +196,13 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   std::map<uint64_t, std::vector<std::string>> non_finalized_blks_;
   std::map<uint64_t, std::vector<std::string>> finalized_blks_;
   DagFrontier frontier_;
+  // Incremented on every change of the pivot tree, guarded by mutex_
+  uint64_t dag_version_ = 0;
+  // The last computed GHOST path with its anchor and the DAG version it was computed at
+  mutable std::mutex ghost_path_cache_mu_;
+  mutable blk_hash_t ghost_path_cache_anchor_;
+  mutable uint64_t ghost_path_cache_version_ = 0;
+  mutable std::shared_ptr<std::vector<blk_hash_t> const> ghost_path_cache_;
   LOG_OBJECTS_DEFINE;
 };
 
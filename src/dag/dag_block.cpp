@@ -105,9 +105,11 @@ DagBlock::DagBlock(dev::RLP const &rlp) {
 }
 
 std::vector<trx_hash_t> DagBlock::extract_transactions_from_rlp(RLP const &rlp) {
-  return rlp[5].toVector<trx_hash_t>();
+  return transactions_rlp(rlp).toVector<trx_hash_t>();
 }
 
+RLP DagBlock::transactions_rlp(RLP const &rlp) { return rlp[5]; }
+
 bool DagBlock::isValid() const {
   return !(pivot_.isZero() && hash_.isZero() && sig_.isZero() && cached_sender_.isZero());
 }
@@ -31,6 +31,8 @@ class DagBlock {
   explicit DagBlock(dev::bytes const &_rlp) : DagBlock(dev::RLP(_rlp)) {}
 
   static std::vector<trx_hash_t> extract_transactions_from_rlp(dev::RLP const &rlp);
+  // Transactions hashes list without decoding, points into rlp memory
+  static dev::RLP transactions_rlp(dev::RLP const &rlp);
 
   friend std::ostream &operator<<(std::ostream &str, DagBlock const &u) {
     str << "	pivot		= " << u.pivot_.abridged() << std::endl;
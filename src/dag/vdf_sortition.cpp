@@ -98,16 +98,19 @@ Json::Value VdfSortition::getJson() const {
   return res;
 }
 
-void VdfSortition::computeVdfSolution(VdfConfig const& config, bytes const& msg) {
-  if (!omitVdf(config)) {
-    auto t1 = getCurrentTimeMilliSeconds();
-    VerifierWesolowski verifier(config.lambda_bound, difficulty_, msg, N);
-
-    ProverWesolowski prover;
-    vdf_sol_ = prover(verifier);  // this line takes time ...
-    auto t2 = getCurrentTimeMilliSeconds();
-    vdf_computation_time_ = t2 - t1;
+bool VdfSortition::computeVdfSolution(VdfConfig const& config, bytes const& msg, std::atomic_bool const& cancelled) {
+  if (omitVdf(config)) {
+    return true;
   }
+  auto t1 = getCurrentTimeMilliSeconds();
+  auto solution = proveWesolowski(config.lambda_bound, difficulty_, msg, N, cancelled);  // this line takes time ...
+  if (!solution) {
+    return false;
+  }
+  vdf_sol_ = std::move(*solution);
+  auto t2 = getCurrentTimeMilliSeconds();
+  vdf_computation_time_ = t2 - t1;
+  return true;
 }
 
 bool VdfSortition::verifyVdf(VdfConfig const& config, bytes const& vrf_input, bytes const& vdf_input) {
@@ -126,8 +129,7 @@ bool VdfSortition::verifyVdf(VdfConfig const& config, bytes const& vrf_input, by
     }
 
     // Verify VDF solution
-    VerifierWesolowski verifier(config.lambda_bound, getDifficulty(), vdf_input, N);
-    if (!verifier(vdf_sol_)) {
+    if (!verifyWesolowski(config.lambda_bound, getDifficulty(), vdf_input, N, vdf_sol_)) {
       LOG(log_er_) << "VDF solution verification failed. VDF input " << vdf_input << ", lambda " << config.lambda_bound
                    << ", difficulty " << getDifficulty();
       return false;
@@ -1,17 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 
-#include "ProverWesolowski.h"
 #include "common/types.hpp"
 #include "consensus/vrf_wrapper.hpp"
+#include "dag/vdf_wesolowski.hpp"
 #include "libdevcore/CommonData.h"
 #include "logger/log.hpp"
-#include "openssl/bn.h"
 
 namespace taraxa::vdf_sortition {
 
-using namespace vdf;
 using namespace vrf_wrapper;
 
 struct VdfConfig {
@@ -61,7 +60,8 @@ class VdfSortition : public vrf_wrapper::VrfSortitionBase {
   explicit VdfSortition(addr_t node_addr, bytes const& b);
   explicit VdfSortition(addr_t node_addr, Json::Value const& json);
 
-  void computeVdfSolution(VdfConfig const& config, dev::bytes const& msg);
+  // Returns false if it was cancelled before the solution was computed, the solution is left empty then
+  bool computeVdfSolution(VdfConfig const& config, dev::bytes const& msg, std::atomic_bool const& cancelled = false);
   bool verifyVdf(VdfConfig const& config, bytes const& vrf_input, bytes const& vdf_input);
 
   bytes rlp() const;
@@ -96,7 +96,7 @@ class VdfSortition : public vrf_wrapper::VrfSortitionBase {
       "cc1ef6a34b2a804a18159c89c39b16edee2ede35");
   bool verifyVrf(bytes const& vrf_input);
 
-  std::pair<bytes, bytes> vdf_sol_;
+  vdf_solution_t vdf_sol_;
   unsigned long vdf_computation_time_ = 0;
   uint16_t difficulty_ = 0;
 
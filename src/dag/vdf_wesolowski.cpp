@@ -0,0 +1,179 @@
+#include "vdf_wesolowski.hpp"
+
+#include <libdevcore/SHA3.h>
+#include <openssl/bn.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace taraxa::vdf_sortition {
+
+namespace {
+
+struct BnDeleter {
+  void operator()(BIGNUM* bn) const { BN_free(bn); }
+};
+struct BnCtxDeleter {
+  void operator()(BN_CTX* ctx) const { BN_CTX_free(ctx); }
+};
+struct BnMontCtxDeleter {
+  void operator()(BN_MONT_CTX* mont) const { BN_MONT_CTX_free(mont); }
+};
+using Bn = std::unique_ptr<BIGNUM, BnDeleter>;
+
+Bn toBn(bytes const& b) { return Bn(BN_bin2bn(b.data(), b.size(), nullptr)); }
+
+bytes toBytes(BIGNUM const* bn) {
+  bytes ret(BN_num_bytes(bn));
+  BN_bn2bin(bn, ret.data());
+  return ret;
+}
+
+// Expands the data to size bytes by hashing it with a counter prefix
+bytes expandHash(bytes const& data, size_t size) {
+  bytes input(4);
+  input.insert(input.end(), data.begin(), data.end());
+  bytes ret;
+  for (uint32_t counter = 0; ret.size() < size; ++counter) {
+    input[0] = counter >> 24;
+    input[1] = counter >> 16;
+    input[2] = counter >> 8;
+    input[3] = counter;
+    auto const h = dev::sha3(input);
+    ret.insert(ret.end(), h.begin(), h.end());
+  }
+  ret.resize(size);
+  return ret;
+}
+
+class Wesolowski {
+ public:
+  // The prime challenge needs at least two bits, one for the top and one to make it odd
+  Wesolowski(uint16_t lambda, uint16_t difficulty, bytes const& msg, bytes const& N)
+      : lambda_(std::max<uint16_t>(lambda, 2)),
+        difficulty_(difficulty),
+        ctx_(BN_CTX_new()),
+        mont_(BN_MONT_CTX_new()),
+        N_(toBn(N)),
+        x_(toBn(expandHash(msg, N.size() + 16))) {
+    BN_MONT_CTX_set(mont_.get(), N_.get(), ctx_.get());
+    BN_mod(x_.get(), x_.get(), N_.get(), ctx_.get());
+  }
+
+  std::optional<vdf_solution_t> prove(std::atomic_bool const& cancelled) {
+    if (difficulty_ >= 64) {
+      throw std::invalid_argument("VDF difficulty must be lower than 64");
+    }
+    uint64_t const t = uint64_t(1) << difficulty_;
+
+    Bn const x_mont(BN_new());
+    BN_to_montgomery(x_mont.get(), x_.get(), mont_.get(), ctx_.get());
+    Bn y(BN_dup(x_mont.get()));
+    for (uint64_t i = 0; i < t; ++i) {
+      if (cancelled) {
+        return {};
+      }
+      BN_mod_mul_montgomery(y.get(), y.get(), y.get(), mont_.get(), ctx_.get());
+    }
+    BN_from_montgomery(y.get(), y.get(), mont_.get(), ctx_.get());
+
+    // pi = x^floor(2^t / l), the quotient bits come from a long division of 2^t by l done along the squarings
+    auto const l = hashPrime(y.get());
+    Bn const one(BN_new());
+    BN_one(one.get());
+    Bn pi(BN_new());
+    BN_to_montgomery(pi.get(), one.get(), mont_.get(), ctx_.get());
+    Bn r(BN_dup(one.get()));
+    for (uint64_t i = 0; i < t; ++i) {
+      if (cancelled) {
+        return {};
+      }
+      BN_mod_mul_montgomery(pi.get(), pi.get(), pi.get(), mont_.get(), ctx_.get());
+      BN_lshift1(r.get(), r.get());
+      if (BN_cmp(r.get(), l.get()) >= 0) {
+        BN_sub(r.get(), r.get(), l.get());
+        BN_mod_mul_montgomery(pi.get(), pi.get(), x_mont.get(), mont_.get(), ctx_.get());
+      }
+    }
+    BN_from_montgomery(pi.get(), pi.get(), mont_.get(), ctx_.get());
+
+    return vdf_solution_t{toBytes(y.get()), toBytes(pi.get())};
+  }
+
+  bool verify(vdf_solution_t const& solution) {
+    auto const y = toBn(solution.first);
+    auto const pi = toBn(solution.second);
+    if (!isCanonical(y.get(), solution.first) || !isCanonical(pi.get(), solution.second)) {
+      return false;
+    }
+
+    // r = 2^t mod l with t = 2^difficulty
+    auto const l = hashPrime(y.get());
+    Bn r(BN_new());
+    BN_set_word(r.get(), 2);
+    BN_mod(r.get(), r.get(), l.get(), ctx_.get());
+    for (uint16_t i = 0; i < difficulty_; ++i) {
+      BN_mod_sqr(r.get(), r.get(), l.get(), ctx_.get());
+    }
+
+    Bn const lhs(BN_new());
+    Bn const x_r(BN_new());
+    BN_mod_exp_mont(lhs.get(), pi.get(), l.get(), N_.get(), ctx_.get(), mont_.get());
+    BN_mod_exp_mont(x_r.get(), x_.get(), r.get(), N_.get(), ctx_.get(), mont_.get());
+    BN_mod_mul(lhs.get(), lhs.get(), x_r.get(), N_.get(), ctx_.get());
+    return BN_cmp(lhs.get(), y.get()) == 0;
+  }
+
+ private:
+  // A group element in [1, N) without leading zero bytes, so a solution has a single encoding
+  bool isCanonical(BIGNUM const* bn, bytes const& b) const {
+    return !BN_is_zero(bn) && BN_cmp(bn, N_.get()) < 0 && toBytes(bn) == b;
+  }
+
+  // The first prime after a lambda bits number drawn from the difficulty, x and y
+  Bn hashPrime(BIGNUM const* y) {
+    bytes input{uint8_t(difficulty_ >> 8), uint8_t(difficulty_)};
+    auto const x_bytes = toBytes(x_.get());
+    input.insert(input.end(), x_bytes.begin(), x_bytes.end());
+    auto const y_bytes = toBytes(y);
+    input.insert(input.end(), y_bytes.begin(), y_bytes.end());
+    auto l = toBn(expandHash(input, (lambda_ + 7) / 8));
+    BN_mask_bits(l.get(), lambda_);
+    BN_set_bit(l.get(), lambda_ - 1);
+    BN_set_bit(l.get(), 0);
+    while (!isPrime(l.get())) {
+      BN_add_word(l.get(), 2);
+    }
+    return l;
+  }
+
+  bool isPrime(BIGNUM const* bn) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    return BN_check_prime(bn, ctx_.get(), nullptr) == 1;
+#else
+    return BN_is_prime_fasttest_ex(bn, BN_prime_checks, ctx_.get(), 1, nullptr) == 1;
+#endif
+  }
+
+  uint16_t const lambda_;
+  uint16_t const difficulty_;
+  std::unique_ptr<BN_CTX, BnCtxDeleter> const ctx_;
+  std::unique_ptr<BN_MONT_CTX, BnMontCtxDeleter> const mont_;
+  Bn const N_;
+  Bn const x_;
+};
+
+}  // namespace
+
+std::optional<vdf_solution_t> proveWesolowski(uint16_t lambda, uint16_t difficulty, bytes const& msg, bytes const& N,
+                                              std::atomic_bool const& cancelled) {
+  return Wesolowski(lambda, difficulty, msg, N).prove(cancelled);
+}
+
+bool verifyWesolowski(uint16_t lambda, uint16_t difficulty, bytes const& msg, bytes const& N,
+                      vdf_solution_t const& solution) {
+  return Wesolowski(lambda, difficulty, msg, N).verify(solution);
+}
+
+}  // namespace taraxa::vdf_sortition
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+#include "common/types.hpp"
+
+// Wesolowski VDF over the group of integers modulo N. The message is hashed into the group as x, the solution is
+// y = x^(2^T) with T = 2^difficulty and the proof pi = x^floor(2^T / l), where l is a lambda bits prime derived from
+// the difficulty, x and y. It is verified by checking pi^l * x^(2^T mod l) == y
+namespace taraxa::vdf_sortition {
+
+using dev::bytes;
+using vdf_solution_t = std::pair<bytes, bytes>;  // y, pi
+
+// Returns nullopt if cancelled, the flag is checked on every squaring so the computation stops right away
+std::optional<vdf_solution_t> proveWesolowski(uint16_t lambda, uint16_t difficulty, bytes const& msg, bytes const& N,
+                                              std::atomic_bool const& cancelled);
+bool verifyWesolowski(uint16_t lambda, uint16_t difficulty, bytes const& msg, bytes const& N,
+                      vdf_solution_t const& solution);
+
+}  // namespace taraxa::vdf_sortition
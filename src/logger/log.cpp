@@ -27,8 +27,41 @@ std::string verbosityToString(int _verbosity) {
 
 }  // namespace
 
+Logger::Logger(Verbosity verbosity, std::string const& channel, uint32_t short_node_id)
+    : severity_channel_logger_mt(boost::log::keywords::severity = verbosity, boost::log::keywords::channel = channel),
+      configured_(true),
+      verbosity_(verbosity),
+      channel_(channel),
+      short_node_id_(short_node_id) {}
+
+Logger::Logger(Logger const& other)
+    : severity_channel_logger_mt(other),
+      configured_(other.configured_),
+      verbosity_(other.verbosity_),
+      channel_(other.channel_),
+      short_node_id_(other.short_node_id_),
+      enabled_cache_(other.enabled_cache_.load()) {}
+
+Logger& Logger::operator=(Logger const& other) {
+  severity_channel_logger_mt::operator=(other);
+  configured_ = other.configured_;
+  verbosity_ = other.verbosity_;
+  channel_ = other.channel_;
+  short_node_id_ = other.short_node_id_;
+  enabled_cache_ = other.enabled_cache_.load();
+  return *this;
+}
+
+bool Logger::updateEnabledCache() const {
+  // Version is read before evaluating, a concurrent config change bumps it and the cache is refreshed again
+  auto const version = filtersVersion();
+  auto const enabled = logger::isEnabled(verbosity_, channel_, short_node_id_);
+  enabled_cache_.store((version << 1) | uint64_t(enabled), std::memory_order_relaxed);
+  return enabled;
+}
+
 Logger createLogger(Verbosity verboseLevel, const std::string& channel, const addr_t& node_id) {
-  Logger logger(boost::log::keywords::severity = verboseLevel, boost::log::keywords::channel = channel);
+  Logger logger(verboseLevel, channel, *(uint32_t*)node_id.data());
   std::string severity_str = verbosityToString(verboseLevel);
   logger.add_attribute("SeverityStr", boost::log::attributes::constant<std::string>(severity_str));
   logger.add_attribute("ShortNodeId", boost::log::attributes::constant<uint32_t>(*(uint32_t*)node_id.data()));
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <boost/log/sources/severity_channel_logger.hpp>
 #include <string>
 
@@ -8,8 +9,41 @@
 
 namespace taraxa::logger {
 
-// Concurrent (Thread-safe) logger type
-using Logger = boost::log::sources::severity_channel_logger_mt<>;
+/**
+ * @brief Concurrent (Thread-safe) severity channel logger
+ * @note Logger knows whether any of the initialized logging configs accepts its records. LOG of a disabled logger costs
+ *       a single atomic load: no record is opened, attributes are not collected and the streamed expressions are not
+ *       evaluated. The answer is cached until logging configs change (see filtersVersion)
+ */
+class Logger : public boost::log::sources::severity_channel_logger_mt<> {
+ public:
+  Logger() = default;
+  Logger(Verbosity verbosity, std::string const& channel, uint32_t short_node_id);
+  Logger(Logger const& other);
+  Logger& operator=(Logger const& other);
+
+  bool isEnabled() const {
+    if (!configured_) {
+      // Not created by createLogger, let the sinks filter decide
+      return true;
+    }
+    auto const cached = enabled_cache_.load(std::memory_order_relaxed);
+    if ((cached >> 1) == filtersVersion()) {
+      return cached & 1;
+    }
+    return updateEnabledCache();
+  }
+
+ private:
+  bool updateEnabledCache() const;
+
+  bool configured_ = false;
+  Verbosity verbosity_ = Verbosity::Error;
+  std::string channel_;
+  uint32_t short_node_id_ = 0;
+  // Filters version shifted left by one with enabled flag in the lowest bit, single atomic so they can't mismatch
+  mutable std::atomic<uint64_t> enabled_cache_ = 0;
+};
 
 /**
  * @brief Creates thread-safe severity channel logger
@@ -56,7 +90,10 @@ void InitLogging(Config& logging_config, const addr_t& node_id);
 
 }  // namespace taraxa::logger
 
-#define LOG BOOST_LOG
+#define LOG(logger)          \
+  if (!(logger).isEnabled()) { \
+  } else                       \
+    BOOST_LOG(logger)
 
 #define LOG_OBJECTS_DEFINE                \
   mutable taraxa::logger::Logger log_si_; \
@@ -5,6 +5,8 @@
 #include <boost/log/attributes/function.hpp>
 #include <boost/log/utility/exception_handler.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "config/config_exception.hpp"
 
@@ -27,13 +29,71 @@ Verbosity stringToVerbosity(std::string _verbosity) {
   throw("Unknown verbosity string");
 }
 
+namespace {
+
+// Filters of the initialized configs, mirrors the filter installed on the sinks
+struct FilterSpec {
+  Verbosity verbosity;
+  std::map<std::string, uint16_t> channels;
+  uint32_t short_node_id;
+};
+
+std::shared_mutex g_filters_mu;
+std::unordered_map<uint64_t, FilterSpec> g_filters;
+uint64_t g_next_filter_id = 1;
+
+template <class Sink, class Filter>
+boost::shared_ptr<Sink> makeSink(boost::shared_ptr<typename Sink::sink_backend_type> backend, Filter const &filter,
+                                 Config::OutputConfig const &output) {
+  backend->auto_flush(true);
+  auto sink = boost::make_shared<Sink>(std::move(backend));
+  sink->set_filter(filter);
+  sink->set_formatter(boost::log::aux::acquire_formatter(output.format));
+  boost::log::core::get()->add_sink(sink);
+  return sink;
+}
+
+template <class Sink>
+void removeSinks(std::vector<boost::shared_ptr<Sink>> &sinks) {
+  for (auto &sink : sinks) {
+    boost::log::core::get()->remove_sink(sink);
+  }
+}
+
+template <class Sink>
+void stopAsyncSinks(std::vector<boost::shared_ptr<Sink>> &sinks) {
+  for (auto &sink : sinks) {
+    boost::log::core::get()->remove_sink(sink);
+    // Writes out what's left in the queue
+    sink->stop();
+    sink->flush();
+  }
+}
+
+}  // namespace
+
+bool isEnabled(Verbosity verbosity, std::string const &channel, uint32_t short_node_id) {
+  std::shared_lock lock(g_filters_mu);
+  for (auto const &[_, filter] : g_filters) {
+    if (filter.channels.empty()) {
+      if (verbosity <= filter.verbosity) return true;
+    } else if (auto it = filter.channels.find(channel); it != filter.channels.end()) {
+      if (filter.short_node_id == short_node_id && verbosity <= it->second) return true;
+    }
+  }
+  return false;
+}
+
 Config::Config(const Config &other)
     : name(other.name),
       verbosity(other.verbosity),
       channels(other.channels),
       outputs(other.outputs),
+      async(other.async),
       console_sinks(other.console_sinks),
-      file_sinks(other.file_sinks) {
+      file_sinks(other.file_sinks),
+      async_console_sinks(other.async_console_sinks),
+      async_file_sinks(other.async_file_sinks) {
   // logging_initialized_ flag is always set to false(in copies) so it is deinitialized
   // only in orig. config object destructor and not also in new copied Config
   logging_initialized_ = false;
@@ -44,8 +104,11 @@ Config &Config::operator=(const Config &other) {
   verbosity = other.verbosity;
   channels = other.channels;
   outputs = other.outputs;
+  async = other.async;
   console_sinks = other.console_sinks;
   file_sinks = other.file_sinks;
+  async_console_sinks = other.async_console_sinks;
+  async_file_sinks = other.async_file_sinks;
 
   // logging_initialized_ flag is always set to false(in copies) so it is deinitialized
   // only in orig. config object destructor and not also in new copied Config
@@ -59,9 +122,13 @@ Config::Config(Config &&other)
       verbosity(std::move(other.verbosity)),
       channels(std::move(other.channels)),
       outputs(std::move(other.outputs)),
+      async(other.async),
       console_sinks(std::move(other.console_sinks)),
       file_sinks(std::move(other.file_sinks)),
-      logging_initialized_(std::move(other.logging_initialized_)) {
+      async_console_sinks(std::move(other.async_console_sinks)),
+      async_file_sinks(std::move(other.async_file_sinks)),
+      logging_initialized_(std::move(other.logging_initialized_)),
+      filter_id_(other.filter_id_) {
   // logging_initialized_ flag in orig. object is always set to false(in moves) so it is not deinitialized
   // in destructor of the orig. config object
   other.logging_initialized_ = false;
@@ -72,9 +139,13 @@ Config &Config::operator=(Config &&other) {
   verbosity = std::move(other.verbosity);
   channels = std::move(other.channels);
   outputs = std::move(other.outputs);
+  async = other.async;
   console_sinks = std::move(other.console_sinks);
   file_sinks = std::move(other.file_sinks);
+  async_console_sinks = std::move(other.async_console_sinks);
+  async_file_sinks = std::move(other.async_file_sinks);
   logging_initialized_ = std::move(other.logging_initialized_);
+  filter_id_ = other.filter_id_;
 
   // logging_initialized_ flag is always set to false(in copies) so it is deinitialized
   // only in orig. config object destructor and not also in new copied Config
@@ -112,33 +183,33 @@ void Config::InitLogging(addr_t const &node) {
 
   for (auto &output : outputs) {
     if (output.type == "console") {
-      auto sink = boost::make_shared<log_sink<boost::log::sinks::text_ostream_backend>>();
-      boost::shared_ptr<std::ostream> stream{&std::cout, boost::null_deleter{}};
-      sink->locked_backend()->add_stream(stream);
-      sink->set_filter(filter);
-
-      sink->set_formatter(boost::log::aux::acquire_formatter(output.format));
-      sink->locked_backend()->auto_flush(true);
-      boost::log::core::get()->add_sink(sink);
-      console_sinks.push_back(sink);
+      auto backend = boost::make_shared<boost::log::sinks::text_ostream_backend>();
+      backend->add_stream(boost::shared_ptr<std::ostream>{&std::cout, boost::null_deleter{}});
+      if (async) {
+        async_console_sinks.push_back(
+            makeSink<async_log_sink<boost::log::sinks::text_ostream_backend>>(std::move(backend), filter, output));
+      } else {
+        console_sinks.push_back(
+            makeSink<log_sink<boost::log::sinks::text_ostream_backend>>(std::move(backend), filter, output));
+      }
     } else if (output.type == "file") {
       std::vector<std::string> v;
       boost::algorithm::split(v, output.time_based_rotation, boost::is_any_of(","));
       if (v.size() != 3)
         throw ConfigException("time_based_rotation not configured correctly" + output.time_based_rotation);
-      auto sink = boost::log::add_file_log(
+      auto backend = boost::make_shared<boost::log::sinks::text_file_backend>(
           boost::log::keywords::file_name = output.file_name,
           boost::log::keywords::rotation_size = output.rotation_size,
           boost::log::keywords::time_based_rotation =
               boost::log::sinks::file::rotation_at_time_point(stoi(v[0]), stoi(v[1]), stoi(v[2])),
           boost::log::keywords::max_size = output.max_size);
-      sink->set_filter(filter);
-
-      sink->set_formatter(boost::log::aux::acquire_formatter(output.format));
-      sink->locked_backend()->auto_flush(true);
-
-      boost::log::core::get()->add_sink(sink);
-      file_sinks.push_back(sink);
+      if (async) {
+        async_file_sinks.push_back(
+            makeSink<async_log_sink<boost::log::sinks::text_file_backend>>(std::move(backend), filter, output));
+      } else {
+        file_sinks.push_back(
+            makeSink<log_sink<boost::log::sinks::text_file_backend>>(std::move(backend), filter, output));
+      }
     }
 
     boost::log::add_common_attributes();
@@ -152,18 +223,29 @@ void Config::InitLogging(addr_t const &node) {
   boost::log::core::get()->set_exception_handler(boost::log::make_exception_handler<std::exception>(
       [](std::exception const &_ex) { std::cerr << "Exception from the logging library: " << _ex.what() << '\n'; }));
 
+  {
+    std::unique_lock lock(g_filters_mu);
+    filter_id_ = g_next_filter_id++;
+    g_filters.emplace(filter_id_, FilterSpec{verbosity, channels, *(uint32_t *)node.data()});
+    detail::filters_version.fetch_add(1, std::memory_order_release);
+  }
+
   logging_initialized_ = true;
 }
 
 void Config::DeinitLogging() {
-  boost::log::core::get()->flush();
-  for (auto &sink : console_sinks) {
-    boost::log::core::get()->remove_sink(sink);
-  }
-  for (auto &sink : file_sinks) {
-    boost::log::core::get()->remove_sink(sink);
+  {
+    std::unique_lock lock(g_filters_mu);
+    g_filters.erase(filter_id_);
+    detail::filters_version.fetch_add(1, std::memory_order_release);
   }
 
+  boost::log::core::get()->flush();
+  removeSinks(console_sinks);
+  removeSinks(file_sinks);
+  stopAsyncSinks(async_console_sinks);
+  stopAsyncSinks(async_file_sinks);
+
   logging_initialized_ = false;
 }
 
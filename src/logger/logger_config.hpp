@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <boost/log/sinks/async_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/utility/setup/file.hpp>
@@ -8,6 +10,7 @@
 #include <vector>
 
 #include "common/types.hpp"
+#include "logger/ring_buffer_queue.hpp"
 
 namespace taraxa::logger {
 
@@ -30,11 +33,33 @@ enum Verbosity {
  */
 Verbosity stringToVerbosity(std::string _verbosity);
 
+/**
+ * @brief Tells whether any initialized logging config accepts records of given verbosity, channel and node
+ *
+ * @note Result changes only when logging is (de)initialized, see filtersVersion
+ */
+bool isEnabled(Verbosity verbosity, std::string const& channel, uint32_t short_node_id);
+
+namespace detail {
+inline std::atomic<uint64_t> filters_version = 1;
+}
+
+/**
+ * @brief Version of the set of initialized logging configs, incremented on each InitLogging/DeinitLogging
+ */
+inline uint64_t filtersVersion() { return detail::filters_version.load(std::memory_order_acquire); }
+
 class Config {
  public:
   template <class T>
   using log_sink = boost::log::sinks::synchronous_sink<T>;
 
+  // Records of async sinks are formatted and written by a background thread, logging threads only push them into a
+  // lock-free ring buffer of this size (records which don't fit are dropped)
+  static constexpr size_t c_async_queue_size = 1 << 16;
+  template <class T>
+  using async_log_sink = boost::log::sinks::asynchronous_sink<T, RingBufferQueue<c_async_queue_size>>;
+
   struct OutputConfig {
     OutputConfig() = default;
 
@@ -68,11 +93,17 @@ class Config {
   Verbosity verbosity{Verbosity::Error};
   std::map<std::string, uint16_t> channels;
   std::vector<OutputConfig> outputs;
+  // Use asynchronous sinks for all outputs of this config
+  bool async{false};
   std::vector<boost::shared_ptr<log_sink<boost::log::sinks::text_ostream_backend>>> console_sinks;
   std::vector<boost::shared_ptr<log_sink<boost::log::sinks::text_file_backend>>> file_sinks;
+  std::vector<boost::shared_ptr<async_log_sink<boost::log::sinks::text_ostream_backend>>> async_console_sinks;
+  std::vector<boost::shared_ptr<async_log_sink<boost::log::sinks::text_file_backend>>> async_file_sinks;
 
  private:
   bool logging_initialized_{false};
+  // Id of this config's filter in the registry used by isEnabled, valid while logging is initialized
+  uint64_t filter_id_{0};
 };
 
 }  // namespace taraxa::logger
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <boost/log/core/record_view.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+
+namespace taraxa::logger {
+
+/**
+ * Queueing strategy for boost::log::sinks::asynchronous_sink backed by a bounded lock-free ring buffer.
+ *
+ * Producers (threads that log) never block and never take a lock: a record which doesn't fit into a full buffer is
+ * dropped and counted, the number of dropped records is reported by the feeding thread. The feeding thread spins over
+ * the buffer and only sleeps on a condition variable when it is empty.
+ *
+ * The buffer is the bounded MPMC queue by Dmitry Vyukov, every cell carries a sequence number telling whether it's
+ * ready to be written or read.
+ */
+template <size_t Capacity>
+class RingBufferQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    boost::log::record_view record;
+  };
+
+ protected:
+  RingBufferQueue() {
+    for (size_t i = 0; i < Capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  template <typename ArgsT>
+  explicit RingBufferQueue(ArgsT const&) : RingBufferQueue() {}
+
+  void enqueue(boost::log::record_view const& rec) {
+    if (!push(rec)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    // Pairs with the fence in dequeue_ready, either the consumer sees the record or we see it's going to sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_sleeping_.load(std::memory_order_relaxed)) {
+      std::lock_guard lock(mu_);
+      cv_.notify_one();
+    }
+  }
+
+  bool try_enqueue(boost::log::record_view const& rec) {
+    enqueue(rec);
+    return true;
+  }
+
+  bool try_dequeue_ready(boost::log::record_view& rec) { return try_dequeue(rec); }
+
+  bool try_dequeue(boost::log::record_view& rec) {
+    if (!pop(rec)) {
+      return false;
+    }
+    reportDropped();
+    return true;
+  }
+
+  bool dequeue_ready(boost::log::record_view& rec) {
+    for (uint32_t spin = 0;; ++spin) {
+      if (try_dequeue(rec)) {
+        return true;
+      }
+      if (interrupted_.exchange(false, std::memory_order_acquire)) {
+        return false;
+      }
+      if (spin < c_spins_before_sleep) {
+        continue;
+      }
+      std::unique_lock lock(mu_);
+      consumer_sleeping_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!pop(rec)) {
+        // Timeout is just a safety net, producers notify when the consumer is sleeping
+        cv_.wait_for(lock, std::chrono::milliseconds(100));
+        consumer_sleeping_.store(false, std::memory_order_relaxed);
+        continue;
+      }
+      consumer_sleeping_.store(false, std::memory_order_relaxed);
+      reportDropped();
+      return true;
+    }
+  }
+
+  void interrupt_dequeue() {
+    interrupted_.store(true, std::memory_order_release);
+    std::lock_guard lock(mu_);
+    cv_.notify_one();
+  }
+
+ private:
+  static constexpr size_t c_mask = Capacity - 1;
+  static constexpr uint32_t c_spins_before_sleep = 64;
+
+  bool push(boost::log::record_view const& rec) {
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[pos & c_mask];
+      auto const seq = cell->sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->record = rec;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(boost::log::record_view& rec) {
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[pos & c_mask];
+      auto const seq = cell->sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    rec = std::move(cell->record);
+    cell->record = boost::log::record_view();
+    cell->sequence.store(pos + Capacity, std::memory_order_release);
+    return true;
+  }
+
+  void reportDropped() {
+    if (dropped_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    if (auto const dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+      std::cerr << "Logging queue overflow, " << dropped << " log records dropped" << std::endl;
+    }
+  }
+
+  std::array<Cell, Capacity> cells_;
+  alignas(64) std::atomic<size_t> enqueue_pos_ = 0;
+  alignas(64) std::atomic<size_t> dequeue_pos_ = 0;
+  alignas(64) std::atomic<uint64_t> dropped_ = 0;
+  std::atomic<bool> consumer_sleeping_ = false;
+  std::atomic<bool> interrupted_ = false;
+  std::mutex mu_;
+  std::condition_variable cv_;
+};
+
+}  // namespace taraxa::logger
@@ -0,0 +1,214 @@
+#include "network_metrics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace taraxa {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Items are pairs of prometheus labels and pointer to the metrics, field selects the counter/histogram to output
+template <typename Items, typename Field>
+void appendCounter(std::ostream &strm, std::string const &name, Items const &items, Field const &field) {
+  strm << "# TYPE " << name << " counter\n";
+  for (auto const &[labels, metrics] : items) {
+    strm << name << '{' << labels << "} " << field(*metrics)->load(std::memory_order_relaxed) << '\n';
+  }
+}
+
+template <typename Items, typename Field>
+void appendHistogram(std::ostream &strm, std::string const &name, Items const &items, Field const &field) {
+  strm << "# TYPE " << name << " histogram\n";
+  for (auto const &[labels, metrics] : items) {
+    field(*metrics)->toPrometheus(strm, name, labels);
+  }
+}
+
+}  // namespace
+
+void LatencyHistogram::observe(std::chrono::microseconds duration) {
+  auto const us = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+  size_t bucket = 0;
+  while (bucket < c_bucket_bounds_us.size() && us > c_bucket_bounds_us[bucket]) {
+    ++bucket;
+  }
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  sum_us_.fetch_add(us, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+Json::Value LatencyHistogram::toJson() const {
+  Json::Value res;
+  auto const total = count();
+  res["count"] = Json::UInt64(total);
+  res["sum_us"] = Json::UInt64(sumUs());
+  if (total > 0) {
+    res["avg_us"] = Json::UInt64(sumUs() / total);
+  }
+  Json::Value buckets(Json::objectValue);
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    auto const bucket = buckets_[i].load(std::memory_order_relaxed);
+    if (bucket == 0) continue;
+    auto const bound = i < c_bucket_bounds_us.size() ? std::to_string(c_bucket_bounds_us[i]) : std::string("inf");
+    buckets["le_" + bound + "_us"] = Json::UInt64(bucket);
+  }
+  res["buckets"] = buckets;
+  return res;
+}
+
+void LatencyHistogram::toPrometheus(std::ostream &strm, std::string const &name, std::string const &labels) const {
+  auto const separator = labels.empty() ? "" : ",";
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    cumulative += buckets_[i].load(std::memory_order_relaxed);
+    strm << name << "_bucket{" << labels << separator << "le=\"";
+    if (i < c_bucket_bounds_us.size()) {
+      // Prometheus convention is base units, bounds are converted to seconds
+      strm << static_cast<double>(c_bucket_bounds_us[i]) / 1e6;
+    } else {
+      strm << "+Inf";
+    }
+    strm << "\"} " << cumulative << '\n';
+  }
+  strm << name << "_sum{" << labels << "} " << static_cast<double>(sumUs()) / 1e6 << '\n';
+  strm << name << "_count{" << labels << "} " << count() << '\n';
+}
+
+void TrafficCounters::toJson(Json::Value &res) const {
+  res["packets_in"] = Json::UInt64(packets_in.load(std::memory_order_relaxed));
+  res["bytes_in"] = Json::UInt64(bytes_in.load(std::memory_order_relaxed));
+  res["packets_out"] = Json::UInt64(packets_out.load(std::memory_order_relaxed));
+  res["bytes_out"] = Json::UInt64(bytes_out.load(std::memory_order_relaxed));
+}
+
+NetworkMetrics::NetworkMetrics(std::vector<std::string> packet_names)
+    : packet_names_(std::move(packet_names)), packets_(new PacketMetrics[packet_names_.size()]) {}
+
+PacketMetrics &NetworkMetrics::packet(unsigned packet_type) {
+  assert(packet_type < packet_names_.size());
+  return packets_[packet_type];
+}
+
+PacketMetrics const &NetworkMetrics::packet(unsigned packet_type) const {
+  assert(packet_type < packet_names_.size());
+  return packets_[packet_type];
+}
+
+void NetworkMetrics::addPeer(dev::p2p::NodeID const &node_id) {
+  boost::unique_lock<boost::shared_mutex> lock(peers_mutex_);
+  peers_.emplace(node_id, std::make_shared<PeerMetrics>());
+}
+
+void NetworkMetrics::removePeer(dev::p2p::NodeID const &node_id) {
+  boost::unique_lock<boost::shared_mutex> lock(peers_mutex_);
+  peers_.erase(node_id);
+}
+
+std::shared_ptr<PeerMetrics> NetworkMetrics::peer(dev::p2p::NodeID const &node_id) const {
+  boost::shared_lock<boost::shared_mutex> lock(peers_mutex_);
+  if (auto it = peers_.find(node_id); it != peers_.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void NetworkMetrics::onReceived(dev::p2p::NodeID const &node_id, unsigned packet_type, uint64_t size) {
+  packet(packet_type).traffic.onReceived(size);
+  if (auto peer_metrics = peer(node_id)) {
+    peer_metrics->traffic.onReceived(size);
+  }
+}
+
+void NetworkMetrics::onSent(dev::p2p::NodeID const &node_id, unsigned packet_type, uint64_t size) {
+  packet(packet_type).traffic.onSent(size);
+  if (auto peer_metrics = peer(node_id)) {
+    peer_metrics->traffic.onSent(size);
+  }
+}
+
+void NetworkMetrics::onHandled(dev::p2p::NodeID const &node_id, unsigned packet_type,
+                               std::chrono::microseconds duration) {
+  packet(packet_type).handler.observe(duration);
+  if (auto peer_metrics = peer(node_id)) {
+    peer_metrics->handler.observe(duration);
+  }
+}
+
+Json::Value NetworkMetrics::toJson() const {
+  Json::Value res;
+  Json::Value packets(Json::objectValue);
+  for (size_t i = 0; i < packet_names_.size(); ++i) {
+    auto const &metrics = packets_[i];
+    Json::Value packet;
+    metrics.traffic.toJson(packet);
+    packet["unique_in"] = Json::UInt64(metrics.unique_in.load(std::memory_order_relaxed));
+    packet["decode"] = metrics.decode.toJson();
+    packet["handler"] = metrics.handler.toJson();
+    packet["queue_wait"] = metrics.queue_wait.toJson();
+    packets[packet_names_[i]] = packet;
+  }
+  res["packets"] = packets;
+  Json::Value peers(Json::objectValue);
+  {
+    boost::shared_lock<boost::shared_mutex> lock(peers_mutex_);
+    for (auto const &[node_id, metrics] : peers_) {
+      Json::Value peer;
+      metrics->traffic.toJson(peer);
+      peer["handler"] = metrics->handler.toJson();
+      peers[node_id.toString()] = peer;
+    }
+  }
+  res["peers"] = peers;
+  return res;
+}
+
+std::string NetworkMetrics::toPrometheus() const {
+  // All samples of a metric family must form a single group in the text format, hence family by family output
+  std::vector<std::pair<std::string, PacketMetrics const *>> packets;
+  for (size_t i = 0; i < packet_names_.size(); ++i) {
+    packets.emplace_back("packet=\"" + packet_names_[i] + "\"", &packets_[i]);
+  }
+  std::vector<std::pair<std::string, std::shared_ptr<PeerMetrics>>> peers;
+  {
+    boost::shared_lock<boost::shared_mutex> lock(peers_mutex_);
+    for (auto const &[node_id, metrics] : peers_) {
+      peers.emplace_back("peer=\"" + node_id.abridged() + "\"", metrics);
+    }
+  }
+  std::ostringstream strm;
+  auto append_traffic = [&strm](std::string const &prefix, auto const &items) {
+    appendCounter(strm, prefix + "_packets_received_total", items, [](auto const &m) { return &m.traffic.packets_in; });
+    appendCounter(strm, prefix + "_bytes_received_total", items, [](auto const &m) { return &m.traffic.bytes_in; });
+    appendCounter(strm, prefix + "_packets_sent_total", items, [](auto const &m) { return &m.traffic.packets_out; });
+    appendCounter(strm, prefix + "_bytes_sent_total", items, [](auto const &m) { return &m.traffic.bytes_out; });
+  };
+  append_traffic("taraxa_network_packet", packets);
+  appendCounter(strm, "taraxa_network_packet_unique_received_total", packets,
+                [](auto const &m) { return &m.unique_in; });
+  appendHistogram(strm, "taraxa_network_packet_decode_seconds", packets, [](auto const &m) { return &m.decode; });
+  appendHistogram(strm, "taraxa_network_packet_handler_seconds", packets, [](auto const &m) { return &m.handler; });
+  appendHistogram(strm, "taraxa_network_packet_queue_wait_seconds", packets,
+                  [](auto const &m) { return &m.queue_wait; });
+  append_traffic("taraxa_network_peer", peers);
+  appendHistogram(strm, "taraxa_network_peer_handler_seconds", peers, [](auto const &m) { return &m.handler; });
+  return strm.str();
+}
+
+void NetworkMetrics::dumpPrometheus(std::string const &file_path) const {
+  auto const tmp_path = file_path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    if (!file) {
+      throw std::runtime_error("Cannot open network metrics file " + tmp_path);
+    }
+    file << toPrometheus();
+  }
+  fs::rename(tmp_path, file_path);
+}
+
+}  // namespace taraxa
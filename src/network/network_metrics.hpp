@@ -0,0 +1,111 @@
+#pragma once
+
+#include <json/json.h>
+#include <libp2p/Common.h>
+
+#include <array>
+#include <atomic>
+#include <boost/thread/shared_mutex.hpp>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace taraxa {
+
+// Histogram of durations with fixed exponential buckets, observing is lock-free
+class LatencyHistogram {
+ public:
+  // Upper bounds of the buckets in microseconds, values above the last one fall into the +Inf bucket
+  static constexpr std::array<uint64_t, 12> c_bucket_bounds_us = {
+      10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000};
+
+  void observe(std::chrono::microseconds duration);
+  void observeSince(std::chrono::steady_clock::time_point begin) {
+    observe(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin));
+  }
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t sumUs() const { return sum_us_.load(std::memory_order_relaxed); }
+
+  Json::Value toJson() const;
+  // Appends histogram in prometheus text format, labels are expected as `key="value",...` without braces
+  void toPrometheus(std::ostream &strm, std::string const &name, std::string const &labels) const;
+
+ private:
+  std::array<std::atomic<uint64_t>, c_bucket_bounds_us.size() + 1> buckets_{};
+  std::atomic<uint64_t> count_ = 0;
+  std::atomic<uint64_t> sum_us_ = 0;
+};
+
+struct TrafficCounters {
+  std::atomic<uint64_t> packets_in = 0;
+  std::atomic<uint64_t> bytes_in = 0;
+  std::atomic<uint64_t> packets_out = 0;
+  std::atomic<uint64_t> bytes_out = 0;
+
+  void onReceived(uint64_t size) {
+    packets_in.fetch_add(1, std::memory_order_relaxed);
+    bytes_in.fetch_add(size, std::memory_order_relaxed);
+  }
+  void onSent(uint64_t size) {
+    packets_out.fetch_add(1, std::memory_order_relaxed);
+    bytes_out.fetch_add(size, std::memory_order_relaxed);
+  }
+  void toJson(Json::Value &res) const;
+};
+
+struct PacketMetrics {
+  TrafficCounters traffic;
+  // Received packets which carried something not known before
+  std::atomic<uint64_t> unique_in = 0;
+  // Time spent decoding payload into objects, only for packets where decoding precedes the processing
+  LatencyHistogram decode;
+  // Time spent in the packet handler (including decoding)
+  LatencyHistogram handler;
+  // Time spent in a local queue, for received packets before being handled (simulated network delay) and for
+  // gossiped transactions before being sent
+  LatencyHistogram queue_wait;
+};
+
+struct PeerMetrics {
+  TrafficCounters traffic;
+  LatencyHistogram handler;
+};
+
+/**
+ * Registry of network telemetry: traffic and latencies per packet type and per connected peer.
+ *
+ * All counters are atomics so they may be updated from any thread without locking, the peers map is guarded by a
+ * shared mutex which is exclusively locked only on connect/disconnect.
+ */
+class NetworkMetrics {
+ public:
+  explicit NetworkMetrics(std::vector<std::string> packet_names);
+
+  PacketMetrics &packet(unsigned packet_type);
+  PacketMetrics const &packet(unsigned packet_type) const;
+
+  void addPeer(dev::p2p::NodeID const &node_id);
+  void removePeer(dev::p2p::NodeID const &node_id);
+  // Returns nullptr for peers which are not connected
+  std::shared_ptr<PeerMetrics> peer(dev::p2p::NodeID const &node_id) const;
+
+  void onReceived(dev::p2p::NodeID const &node_id, unsigned packet_type, uint64_t size);
+  void onSent(dev::p2p::NodeID const &node_id, unsigned packet_type, uint64_t size);
+  void onHandled(dev::p2p::NodeID const &node_id, unsigned packet_type, std::chrono::microseconds duration);
+
+  Json::Value toJson() const;
+  std::string toPrometheus() const;
+  // Writes prometheus text dump to a temporary file which is then renamed, so readers never see a partial dump
+  void dumpPrometheus(std::string const &file_path) const;
+
+ private:
+  std::vector<std::string> const packet_names_;
+  std::unique_ptr<PacketMetrics[]> packets_;
+  std::unordered_map<dev::p2p::NodeID, std::shared_ptr<PeerMetrics>> peers_;
+  mutable boost::shared_mutex peers_mutex_;
+};
+
+}  // namespace taraxa
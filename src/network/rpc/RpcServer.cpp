@@ -9,8 +9,14 @@
 
 namespace taraxa::net {
 
-RpcServer::RpcServer(boost::asio::io_context &io, boost::asio::ip::tcp::endpoint ep, addr_t node_addr)
-    : io_context_(io), acceptor_(io), ep_(std::move(ep)) {
+RpcServer::RpcServer(boost::asio::io_context &io, boost::asio::ip::tcp::endpoint ep, addr_t node_addr,
+                     std::chrono::milliseconds idle_timeout, size_t max_connections, uint16_t batch_threads_num)
+    : io_context_(io),
+      acceptor_(io),
+      ep_(std::move(ep)),
+      idle_timeout_(idle_timeout),
+      max_connections_(max_connections),
+      batch_pool_(batch_threads_num) {
   LOG_OBJECTS_CREATE("RPC");
   LOG(log_si_) << "Taraxa RPC started at port: " << ep_.port();
 }
@@ -48,7 +54,17 @@ void RpcServer::waitForAccept() {
   std::shared_ptr<RpcConnection> connection(std::make_shared<RpcConnection>(getShared()));
   acceptor_.async_accept(connection->getSocket(), [this, connection](boost::system::error_code const &ec) {
     if (!ec) {
-      connection->read();
+      if (connections_count_.fetch_add(1) >= max_connections_) {
+        connections_count_--;
+        LOG(log_wr_) << "Rpc connections limit " << max_connections_ << " reached, rejecting connection";
+        connection->reject();
+      } else {
+        connection->counted_ = true;
+        // Responses are small and written at once, do not let Nagle delay them behind pipelined requests
+        boost::system::error_code no_delay_ec;
+        connection->getSocket().set_option(boost::asio::ip::tcp::no_delay(true), no_delay_ec);
+        connection->read();
+      }
     } else {
       if (stopped_) return;
 
@@ -65,12 +81,107 @@ bool RpcServer::StopListening() {
     return true;
   }
   acceptor_.close();
+  if (batch_pool_.get_executor().running_in_this_thread()) {
+    batch_pool_.stop();
+  } else {
+    batch_pool_.join();
+  }
   LOG(log_tr_) << "StopListening: ";
   return true;
 }
 
 bool RpcServer::SendResponse(const std::string &response, void *addInfo) { return true; }
 
+namespace {
+std::string methodName(Json::Value const &request) {
+  if (request.isObject()) {
+    if (auto const &method = request["method"]; method.isString()) {
+      return method.asString();
+    }
+  }
+  return {};
+}
+}  // namespace
+
+std::optional<std::string> RpcServer::handleRequest(std::string const &body,
+                                                    std::function<void(std::string)> on_batch_response) {
+  Json::Value request;
+  // Malformed requests are left to the handler which responds with proper json-rpc error
+  Json::Reader().parse(body, request, false);
+  if (!request.isArray() || request.size() < 2) {
+    return handleSingleRequest(body, methodName(request.isArray() ? request[0] : request));
+  }
+
+  struct Batch {
+    std::vector<std::string> responses;
+    std::atomic<size_t> pending;
+    std::function<void(std::string)> on_response;
+  };
+  auto batch = std::make_shared<Batch>();
+  batch->responses.resize(request.size());
+  batch->pending = request.size();
+  batch->on_response = std::move(on_batch_response);
+  for (Json::ArrayIndex i = 0; i < request.size(); ++i) {
+    boost::asio::post(batch_pool_, [this, batch, i, element = std::move(request[i])] {
+      batch->responses[i] = handleSingleRequest(Json::FastWriter().write(element), methodName(element));
+      if (batch->pending.fetch_sub(1) != 1) {
+        return;
+      }
+      // Reassemble responses in request order, notifications have no response and are left out
+      std::string response;
+      for (auto &element_response : batch->responses) {
+        while (!element_response.empty() && std::isspace(static_cast<unsigned char>(element_response.back()))) {
+          element_response.pop_back();
+        }
+        if (element_response.empty()) continue;
+        response += response.empty() ? '[' : ',';
+        response += element_response;
+      }
+      if (!response.empty()) {
+        response += ']';
+      }
+      batch->on_response(std::move(response));
+    });
+  }
+  return std::nullopt;
+}
+
+std::string RpcServer::handleSingleRequest(std::string const &request, std::string const &method) {
+  std::string response;
+  if (GetHandler() == NULL) {
+    return response;
+  }
+  auto const begin = std::chrono::steady_clock::now();
+  GetHandler()->HandleRequest(request, response);
+  methodMetrics(method.empty() ? "<invalid>" : method).observeSince(begin);
+  return response;
+}
+
+LatencyHistogram &RpcServer::methodMetrics(std::string const &method) {
+  {
+    boost::shared_lock<boost::shared_mutex> lock(methods_metrics_mutex_);
+    if (auto it = methods_metrics_.find(method); it != methods_metrics_.end()) {
+      return *it->second;
+    }
+  }
+  boost::unique_lock<boost::shared_mutex> lock(methods_metrics_mutex_);
+  auto const &key = methods_metrics_.size() < c_max_tracked_methods ? method : std::string("<other>");
+  auto &histogram = methods_metrics_[key];
+  if (!histogram) {
+    histogram = std::make_unique<LatencyHistogram>();
+  }
+  return *histogram;
+}
+
+Json::Value RpcServer::getMethodsMetrics() const {
+  Json::Value res(Json::objectValue);
+  boost::shared_lock<boost::shared_mutex> lock(methods_metrics_mutex_);
+  for (auto const &[method, histogram] : methods_metrics_) {
+    res[method] = histogram->toJson();
+  }
+  return res;
+}
+
 std::shared_ptr<RpcConnection> RpcConnection::getShared() {
   try {
     return shared_from_this();
@@ -80,52 +191,91 @@ std::shared_ptr<RpcConnection> RpcConnection::getShared() {
   }
 }
 
-RpcConnection::RpcConnection(std::shared_ptr<RpcServer> rpc) : rpc_(rpc), socket_(rpc->getIoContext()) {
+RpcConnection::RpcConnection(std::shared_ptr<RpcServer> rpc) : rpc_(rpc), stream_(rpc->getIoContext()) {
   responded_.clear();
 }
 
+RpcConnection::~RpcConnection() {
+  if (counted_) {
+    rpc_->connections_count_--;
+  }
+}
+
 void RpcConnection::read() {
+  // Each request must be parsed into a fresh message, leftover bytes of pipelined requests stay in buffer_
+  request_ = {};
+  response_ = {};
+  responded_.clear();
+  stream_.expires_after(rpc_->idle_timeout_);
   auto this_sp = getShared();
   boost::beast::http::async_read(
-      socket_, buffer_, request_, [this_sp](boost::system::error_code const &ec, size_t byte_transfered) {
-        if (!ec) {
-          // define response handler
-          auto replier([this_sp](std::string const &msg) {
-            // prepare response content
-            std::string body = msg;
-            this_sp->write_response(msg);
-            // async write
-            boost::beast::http::async_write(this_sp->socket_, this_sp->response_,
-                                            [this_sp](boost::system::error_code const &ec, size_t byte_transfered) {});
+      stream_, buffer_, request_, [this_sp](boost::system::error_code const &ec, size_t byte_transfered) {
+        if (ec == boost::beast::http::error::end_of_stream || ec == boost::beast::error::timeout) {
+          // Client closed the connection or kept it idle for too long
+          this_sp->close();
+          return;
+        }
+        if (ec) {
+          LOG(this_sp->rpc_->log_er_) << "Error! RPC conncetion read fail ... " << ec.message() << "\n";
+          return;
+        }
+        if (this_sp->request_.method() == boost::beast::http::verb::options) {
+          this_sp->write_options_response();
+        } else if (this_sp->request_.method() == boost::beast::http::verb::post) {
+          LOG(this_sp->rpc_->log_tr_) << "Read: " << this_sp->request_.body();
+          auto response = this_sp->rpc_->handleRequest(this_sp->request_.body(), [this_sp](std::string response) {
+            // Batch is answered from a worker thread, get back to the connection's executor to write it
+            boost::asio::post(this_sp->stream_.get_executor(), [this_sp, response = std::move(response)] {
+              LOG(this_sp->rpc_->log_tr_) << "Write: " << response;
+              this_sp->write_response(response);
+              this_sp->write();
+            });
           });
-          if (this_sp->request_.method() == boost::beast::http::verb::options) {
-            this_sp->write_options_response();
-            // async write
-            boost::beast::http::async_write(this_sp->socket_, this_sp->response_,
-                                            [this_sp](boost::system::error_code const &ec, size_t byte_transfered) {});
-          }
-          if (this_sp->request_.method() == boost::beast::http::verb::post) {
-            string response;
-            if (this_sp->rpc_->GetHandler() != NULL) {
-              LOG(this_sp->rpc_->log_tr_) << "Read: " << this_sp->request_.body();
-              this_sp->rpc_->GetHandler()->HandleRequest(this_sp->request_.body(), response);
-            }
-            LOG(this_sp->rpc_->log_tr_) << "Write: " << response;
-            replier(response);
+          if (!response) {
+            return;
           }
+          LOG(this_sp->rpc_->log_tr_) << "Write: " << *response;
+          this_sp->write_response(*response);
         } else {
-          LOG(this_sp->rpc_->log_er_) << "Error! RPC conncetion read fail ... " << ec.message() << "\n";
+          // Nothing to respond with, connection can't be reused
+          this_sp->close();
+          return;
         }
+        this_sp->write();
         (void)byte_transfered;
       });
 }
 
+void RpcConnection::write() {
+  stream_.expires_after(rpc_->idle_timeout_);
+  auto this_sp = getShared();
+  boost::beast::http::async_write(stream_, response_,
+                                  [this_sp](boost::system::error_code const &ec, size_t byte_transfered) {
+                                    if (ec) {
+                                      LOG(this_sp->rpc_->log_dg_) << "RPC connection write fail " << ec.message();
+                                      return;
+                                    }
+                                    if (!this_sp->response_.keep_alive() || this_sp->rpc_->stopped_) {
+                                      this_sp->close();
+                                      return;
+                                    }
+                                    this_sp->read();
+                                    (void)byte_transfered;
+                                  });
+}
+
+void RpcConnection::close() {
+  boost::system::error_code ec;
+  stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ec);
+}
+
 void RpcConnection::write_response(std::string const &msg) {
   if (!responded_.test_and_set()) {
+    response_.version(request_.version());
     response_.set("Content-Type", "application/json");
     response_.set("Access-Control-Allow-Origin", "*");
     response_.set("Access-Control-Allow-Headers", "Accept, Accept-Language, Content-Language, Content-Type");
-    response_.set("Connection", "close");
+    response_.keep_alive(request_.keep_alive());
     response_.result(boost::beast::http::status::ok);
     response_.body() = msg;
     response_.prepare_payload();
@@ -136,10 +286,11 @@ void RpcConnection::write_response(std::string const &msg) {
 
 void RpcConnection::write_options_response() {
   if (!responded_.test_and_set()) {
+    response_.version(request_.version());
     response_.set("Allow", "OPTIONS, GET, HEAD, POST");
     response_.set("Access-Control-Allow-Origin", "*");
     response_.set("Access-Control-Allow-Headers", "Accept, Accept-Language, Content-Language, Content-Type");
-    response_.set("Connection", "close");
+    response_.keep_alive(request_.keep_alive());
     response_.result(boost::beast::http::status::no_content);
     response_.prepare_payload();
   } else {
@@ -147,4 +298,14 @@ void RpcConnection::write_options_response() {
   }
 }
 
-}  // namespace taraxa::net
\ No newline at end of file
+void RpcConnection::reject() {
+  response_.result(boost::beast::http::status::service_unavailable);
+  response_.keep_alive(false);
+  response_.prepare_payload();
+  stream_.expires_after(rpc_->idle_timeout_);
+  auto this_sp = getShared();
+  boost::beast::http::async_write(stream_, response_,
+                                  [this_sp](boost::system::error_code const &, size_t) { this_sp->close(); });
+}
+
+}  // namespace taraxa::net
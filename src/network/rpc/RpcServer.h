@@ -1,13 +1,20 @@
 #pragma once
 
+#include <json/json.h>
 #include <jsonrpccpp/server/abstractserverconnector.h>
 
 #include <atomic>
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <chrono>
+#include <functional>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 #include "config/config.hpp"
+#include "network/network_metrics.hpp"
 
 namespace taraxa::net {
 
@@ -16,23 +23,46 @@ class RpcHandler;
 
 class RpcServer : public std::enable_shared_from_this<RpcServer>, public jsonrpc::AbstractServerConnector {
  public:
-  RpcServer(boost::asio::io_context &io, boost::asio::ip::tcp::endpoint ep, addr_t node_addr);
+  RpcServer(boost::asio::io_context &io, boost::asio::ip::tcp::endpoint ep, addr_t node_addr,
+            std::chrono::milliseconds idle_timeout = std::chrono::milliseconds(30000), size_t max_connections = 1000,
+            uint16_t batch_threads_num = 4);
   virtual ~RpcServer() { RpcServer::StopListening(); }
 
   virtual bool StartListening() override;
+  // Waits for the running batches, must be called by the owner before releasing the server: the last reference can
+  // otherwise be dropped by a batch on the pool which can't join itself
   virtual bool StopListening() override;
   virtual bool SendResponse(const std::string &response, void *addInfo = NULL);
   void waitForAccept();
   boost::asio::io_context &getIoContext() { return io_context_; }
   std::shared_ptr<RpcServer> getShared();
+  // Latency histograms of the served requests per json-rpc method
+  Json::Value getMethodsMetrics() const;
   friend RpcConnection;
   friend RpcHandler;
 
  private:
+  // Returns response right away for single requests, batches are split into requests executed concurrently on
+  // batch_pool_, in which case nullopt is returned and on_batch_response is called from a worker thread when done
+  std::optional<std::string> handleRequest(std::string const &body,
+                                           std::function<void(std::string)> on_batch_response);
+  std::string handleSingleRequest(std::string const &request, std::string const &method);
+  LatencyHistogram &methodMetrics(std::string const &method);
+
   std::atomic<bool> stopped_ = true;
   boost::asio::io_context &io_context_;
   boost::asio::ip::tcp::endpoint ep_;
   boost::asio::ip::tcp::acceptor acceptor_;
+  // Keep-alive connection is closed after not receiving a request for this long
+  std::chrono::milliseconds const idle_timeout_;
+  size_t const max_connections_;
+  std::atomic<size_t> connections_count_ = 0;
+  // Elements of batch requests are executed here, separately from the io threads
+  boost::asio::thread_pool batch_pool_;
+  // Number of distinct method names tracked, so that random names sent by clients can't grow the map unbounded
+  static constexpr size_t c_max_tracked_methods = 256;
+  std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>> methods_metrics_;
+  mutable boost::shared_mutex methods_metrics_mutex_;
   LOG_OBJECTS_DEFINE;
 };
 // QQ:
@@ -45,19 +75,28 @@ class RpcServer : public std::enable_shared_from_this<RpcServer>, public jsonrpc
 // QQ:
 // atomic_flag responded, is RpcConnection multithreaded??
 
+// Persistent (HTTP/1.1 keep-alive) connection, requests are served one after another in the order they were received,
+// so pipelined requests are answered in order as well. At most one async operation is pending at any time.
 class RpcConnection : public std::enable_shared_from_this<RpcConnection> {
  public:
   explicit RpcConnection(std::shared_ptr<RpcServer> rpc);
-  virtual ~RpcConnection() = default;
+  virtual ~RpcConnection();
   virtual void read();
   virtual void write_response(std::string const &msg);
   virtual void write_options_response();
-  boost::asio::ip::tcp::socket &getSocket() { return socket_; }
+  // Responds with 503 and closes the connection, used when server is at its connections limit
+  virtual void reject();
+  boost::asio::ip::tcp::socket &getSocket() { return stream_.socket(); }
   virtual std::shared_ptr<RpcConnection> getShared();
+  friend RpcServer;
 
  private:
+  void write();
+  void close();
+
   std::shared_ptr<RpcServer> rpc_;
-  boost::asio::ip::tcp::socket socket_;
+  boost::beast::tcp_stream stream_;
+  bool counted_ = false;
   boost::beast::flat_buffer buffer_;
   boost::beast::http::request<boost::beast::http::string_body> request_;
   boost::beast::http::response<boost::beast::http::string_body> response_;
@@ -416,6 +416,35 @@ Json::Value Test::get_dag_blk_count(const Json::Value &param1) {
   return res;
 }
 
+Json::Value Test::get_network_metrics() {
+  Json::Value res;
+  try {
+    if (auto node = full_node_.lock()) {
+      res = node->getNetwork()->getTaraxaCapability()->getMetrics().toJson();
+    }
+  } catch (std::exception &e) {
+    res["status"] = e.what();
+  }
+  return res;
+}
+
+Json::Value Test::get_rpc_metrics() {
+  Json::Value res;
+  try {
+    if (auto node = full_node_.lock()) {
+      if (auto const &rpc = node->getJsonRpcHttp()) {
+        res["http_methods"] = rpc->getMethodsMetrics();
+      }
+      if (auto const &ws = node->getJsonRpcWs()) {
+        res["ws_queues"] = ws->getQueueMetrics().toJson();
+      }
+    }
+  } catch (std::exception &e) {
+    res["status"] = e.what();
+  }
+  return res;
+}
+
 Json::Value Test::get_pbft_chain_size() {
   Json::Value res;
   try {
@@ -41,6 +41,8 @@ class Test : public TestFace {
   virtual Json::Value get_executed_blk_count(const Json::Value& param1) override;
   virtual Json::Value get_dag_size(const Json::Value& param1) override;
   virtual Json::Value get_dag_blk_count(const Json::Value& param1) override;
+  virtual Json::Value get_network_metrics() override;
+  virtual Json::Value get_rpc_metrics() override;
   virtual Json::Value get_pbft_chain_size() override;
   virtual Json::Value get_pbft_chain_blocks(const Json::Value& param1) override;
 
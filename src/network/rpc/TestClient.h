@@ -211,6 +211,24 @@ class TestClient : public jsonrpc::Client {
     else
       throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
   }
+  Json::Value get_network_metrics() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("get_network_metrics", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value get_rpc_metrics() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("get_rpc_metrics", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
   Json::Value get_pbft_chain_size() throw(jsonrpc::JsonRpcException) {
     Json::Value p;
     p = Json::nullValue;
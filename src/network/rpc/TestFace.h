@@ -75,6 +75,12 @@ class TestFace : public ServerInterface<TestFace> {
     this->bindAndAddMethod(jsonrpc::Procedure("get_dag_blk_count", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
                                               "param1", jsonrpc::JSON_OBJECT, NULL),
                            &taraxa::net::TestFace::get_dag_blk_countI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("get_network_metrics", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::TestFace::get_network_metricsI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("get_rpc_metrics", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::TestFace::get_rpc_metricsI);
     this->bindAndAddMethod(
         jsonrpc::Procedure("get_pbft_chain_size", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
         &taraxa::net::TestFace::get_pbft_chain_sizeI);
@@ -157,6 +163,14 @@ class TestFace : public ServerInterface<TestFace> {
   inline virtual void get_dag_blk_countI(const Json::Value &request, Json::Value &response) {
     response = this->get_dag_blk_count(request[0u]);
   }
+  inline virtual void get_network_metricsI(const Json::Value &request, Json::Value &response) {
+    (void)request;
+    response = this->get_network_metrics();
+  }
+  inline virtual void get_rpc_metricsI(const Json::Value &request, Json::Value &response) {
+    (void)request;
+    response = this->get_rpc_metrics();
+  }
   inline virtual void get_pbft_chain_sizeI(const Json::Value &request, Json::Value &response) {
     (void)request;
     response = this->get_pbft_chain_size();
@@ -186,6 +200,8 @@ class TestFace : public ServerInterface<TestFace> {
   virtual Json::Value get_executed_blk_count(const Json::Value &param1) = 0;
   virtual Json::Value get_dag_size(const Json::Value &param1) = 0;
   virtual Json::Value get_dag_blk_count(const Json::Value &param1) = 0;
+  virtual Json::Value get_network_metrics() = 0;
+  virtual Json::Value get_rpc_metrics() = 0;
   virtual Json::Value get_pbft_chain_size() = 0;
   virtual Json::Value get_pbft_chain_blocks(const Json::Value &param1) = 0;
 };
@@ -72,16 +72,19 @@ void WSSession::on_read(beast::error_code ec, std::size_t bytes_transferred) {
     json_response["jsonrpc"] = "2.0";
     subscription_id_++;
     if (params.size() > 0) {
+      auto subscribe = [this](WSSubscription subscription) {
+        subscriptions_[static_cast<size_t>(subscription)] = subscription_id_;
+      };
       if (params[0].asString() == "newHeads") {
-        new_heads_subscription_ = subscription_id_;
+        subscribe(WSSubscription::new_heads);
       } else if (params[0].asString() == "newPendingTransactions") {
-        new_transactions_subscription_ = subscription_id_;
+        subscribe(WSSubscription::new_pending_transactions);
       } else if (params[0].asString() == "newDagBlocks") {
-        new_dag_blocks_subscription_ = subscription_id_;
+        subscribe(WSSubscription::new_dag_blocks);
       } else if (params[0].asString() == "newDagBlocksFinalized") {
-        new_dag_block_finalized_subscription_ = subscription_id_;
+        subscribe(WSSubscription::new_dag_blocks_finalized);
       } else if (params[0].asString() == "newPbftBlocks") {
-        new_pbft_block_executed_subscription_ = subscription_id_;
+        subscribe(WSSubscription::new_pbft_blocks);
       }
     }
     json_response["result"] = dev::toJS(subscription_id_);
@@ -100,13 +103,8 @@ void WSSession::on_read(beast::error_code ec, std::size_t bytes_transferred) {
       LOG(log_tr_) << "WS Write: " << response;
     }
   }
-  auto executor = ws_.get_executor();
-  if (!executor) {
-    LOG(log_tr_) << "Executor missing - WS closed";
-    closed_ = true;
-    return;
-  }
-  executor.post(boost::bind(&WSSession::writeImpl, this, response), std::allocator<void>());
+  post(WSMessage{nullptr, std::move(response)});
+  if (closed_) return;
   // Clear the buffer
   buffer_.consume(buffer_.size());
 
@@ -128,141 +126,149 @@ void WSSession::on_write_no_read(beast::error_code ec, std::size_t bytes_transfe
 
   boost::ignore_unused(bytes_transferred);
 
-  queue_messages_.pop_front();
-  if (ec) {
-    if (!closed_) LOG(log_er_) << ec << " write";
-    return;
+  dequeue(queue_messages_.begin());
+  if (queue_messages_.size() > 0) {
+    write();
   }
-  // Clear the buffer
-  buffer_.consume(buffer_.size());
+}
 
-  if (queue_messages_.size() > 0) {
-    std::string message = queue_messages_.front();
-    write(message);
+void WSSession::notify(WSSubscription subscription, std::shared_ptr<WSSubscriptionEvent const> const &event) {
+  if (auto const subscription_id = subscriptions_[static_cast<size_t>(subscription)].load()) {
+    post(WSMessage{event, dev::toJS(subscription_id)});
   }
 }
 
-void WSSession::newEthBlock(dev::eth::BlockHeader const &payload) {
-  if (new_heads_subscription_ != 0) {
-    Json::Value res, params;
-    res["jsonrpc"] = "2.0";
-    res["method"] = "eth_subscription";
-    params["result"] = dev::eth::toJson(payload);
-    params["subscription"] = dev::toJS(new_heads_subscription_);
-    res["params"] = params;
-    Json::FastWriter fastWriter;
-    std::string response = fastWriter.write(res);
-    ws_.text(ws_.got_text());
-    LOG(log_tr_) << "WS WRITE " << response.c_str();
-    auto executor = ws_.get_executor();
-    if (!executor) {
-      LOG(log_tr_) << "Executor missing - WS closed";
-      closed_ = true;
-      return;
-    }
-    executor.post(boost::bind(&WSSession::writeImpl, this, response), std::allocator<void>());
+void WSSession::post(WSMessage message) {
+  auto executor = ws_.get_executor();
+  if (!executor) {
+    LOG(log_tr_) << "Executor missing - WS closed";
+    closed_ = true;
+    return;
   }
+  boost::asio::post(executor, [this_sp = shared_from_this(), message = std::move(message)]() mutable {
+    this_sp->writeImpl(std::move(message));
+  });
 }
 
-void WSSession::write(const std::string &message) {
-  write_buffer_ = message;
+void WSSession::write() {
   ws_.text(ws_.got_text());
-  LOG(log_tr_) << "WS ASYNC WRITE " << message.c_str() << " " << &ws_;
-  ws_.async_write(boost::asio::buffer(write_buffer_),
+  LOG(log_tr_) << "WS ASYNC WRITE " << &ws_;
+  ws_.async_write(queue_messages_.front().buffers(),
                   beast::bind_front_handler(&WSSession::on_write_no_read, shared_from_this()));
 }
 
-void WSSession::writeImpl(const std::string &message) {
-  queue_messages_.push_back(message);
+void WSSession::writeImpl(WSMessage message) {
+  if (closed_) return;
+  if (!makeRoom(message)) return;
+  queue_metrics_->queued_messages++;
+  queue_metrics_->queued_bytes += message.size();
+  queue_messages_.push_back(std::move(message));
   if (queue_messages_.size() > 1) {
     // outstanding async_write
     return;
   }
 
-  write(message);
+  write();
 }
 
-void WSSession::newDagBlock(DagBlock const &blk) {
-  if (new_dag_blocks_subscription_) {
-    Json::Value res, params;
-    res["jsonrpc"] = "2.0";
-    res["method"] = "eth_subscription";
-    params["result"] = blk.getJson();
-    params["subscription"] = dev::toJS(new_dag_blocks_subscription_);
-    res["params"] = params;
-    Json::FastWriter fastWriter;
-    std::string response = fastWriter.write(res);
-    auto executor = ws_.get_executor();
-    if (!executor) {
-      LOG(log_tr_) << "Executor missing - WS closed";
-      closed_ = true;
-      return;
+bool WSSession::makeRoom(WSMessage const &message) {
+  if (message.event && queue_metrics_->queued_bytes + message.size() > queue_limits_.max_queued_bytes) {
+    queue_metrics_->dropped_events++;
+    return false;
+  }
+  if (queue_messages_.size() < queue_limits_.max_queue_size) {
+    return true;
+  }
+  if (queue_limits_.overflow_policy == WSOverflowPolicy::disconnect) {
+    LOG(log_nf_) << "WS session outbound queue is full, disconnecting";
+    disconnect();
+    return false;
+  }
+  // Front message is being written, it can't be removed
+  auto const first_queued = std::next(queue_messages_.begin());
+  if (message.event && queue_limits_.overflow_policy == WSOverflowPolicy::coalesce) {
+    auto const same = std::find_if(first_queued, queue_messages_.end(), [&](auto const &queued) {
+      return queued.event && queued.event->subscription == message.event->subscription;
+    });
+    if (same != queue_messages_.end()) {
+      dequeue(same);
+      queue_metrics_->coalesced_events++;
+      return true;
     }
-    executor.post(boost::bind(&WSSession::writeImpl, this, response), std::allocator<void>());
   }
+  auto const oldest_event =
+      std::find_if(first_queued, queue_messages_.end(), [](auto const &queued) { return queued.event != nullptr; });
+  if (oldest_event != queue_messages_.end()) {
+    dequeue(oldest_event);
+    queue_metrics_->dropped_events++;
+    return true;
+  }
+  if (message.event) {
+    queue_metrics_->dropped_events++;
+    return false;
+  }
+  // Queue is full of responses, client sends requests without reading the responses
+  LOG(log_nf_) << "WS session outbound queue is full of responses, disconnecting";
+  disconnect();
+  return false;
 }
 
-void WSSession::newDagBlockFinalized(blk_hash_t const &blk, uint64_t period) {
-  if (new_dag_block_finalized_subscription_) {
-    Json::Value res, params, result;
-    res["jsonrpc"] = "2.0";
-    res["method"] = "eth_subscription";
-    result["block"] = dev::toJS(blk);
-    result["period"] = dev::toJS(period);
-    params["result"] = result;
-    params["subscription"] = dev::toJS(new_dag_block_finalized_subscription_);
-    res["params"] = params;
-    Json::FastWriter fastWriter;
-    std::string response = fastWriter.write(res);
-    auto executor = ws_.get_executor();
-    if (!executor) {
-      LOG(log_tr_) << "Executor missing - WS closed";
-      closed_ = true;
-      return;
-    }
-    executor.post(boost::bind(&WSSession::writeImpl, this, response), std::allocator<void>());
+void WSSession::dequeue(std::deque<WSMessage>::iterator it) {
+  queue_metrics_->queued_messages--;
+  queue_metrics_->queued_bytes -= it->size();
+  queue_messages_.erase(it);
+}
+
+void WSSession::disconnect() {
+  closed_ = true;
+  queue_metrics_->disconnected_sessions++;
+  // Closing the socket cancels pending operations, the message being written is released by the destructor
+  while (queue_messages_.size() > 1) {
+    dequeue(std::prev(queue_messages_.end()));
   }
+  beast::error_code ec;
+  beast::get_lowest_layer(ws_).socket().close(ec);
 }
 
-void WSSession::newPbftBlockExecuted(Json::Value const &payload) {
-  if (new_pbft_block_executed_subscription_) {
-    Json::Value res, params, result;
-    res["jsonrpc"] = "2.0";
-    res["method"] = "eth_subscription";
-    result["pbft_block"] = payload;
-    params["result"] = result;
-    params["subscription"] = dev::toJS(new_pbft_block_executed_subscription_);
-    res["params"] = params;
-    Json::FastWriter fastWriter;
-    std::string response = fastWriter.write(res);
-    auto executor = ws_.get_executor();
-    if (!executor) {
-      LOG(log_tr_) << "Executor missing - WS closed";
-      closed_ = true;
-      return;
-    }
-    executor.post(boost::bind(&WSSession::writeImpl, this, response), std::allocator<void>());
+WSSession::~WSSession() {
+  for (auto const &message : queue_messages_) {
+    queue_metrics_->queued_messages--;
+    queue_metrics_->queued_bytes -= message.size();
   }
 }
 
-void WSSession::newPendingTransaction(trx_hash_t const &trx_hash) {
-  if (new_transactions_subscription_) {
-    Json::Value res, params;
-    res["jsonrpc"] = "2.0";
-    res["method"] = "eth_subscription";
-    params["result"] = dev::toJS(trx_hash);
-    params["subscription"] = dev::toJS(new_transactions_subscription_);
-    res["params"] = params;
-    Json::FastWriter fastWriter;
-    std::string response = fastWriter.write(res);
-    auto executor = ws_.get_executor();
-    if (!executor) {
-      LOG(log_tr_) << "Executor missing - WS closed";
-      closed_ = true;
-      return;
-    }
-    executor.post(boost::bind(&WSSession::writeImpl, this, response), std::allocator<void>());
+WSOverflowPolicy wsOverflowPolicyFromString(std::string const &policy) {
+  if (policy == "drop_oldest") return WSOverflowPolicy::drop_oldest;
+  if (policy == "coalesce") return WSOverflowPolicy::coalesce;
+  if (policy == "disconnect") return WSOverflowPolicy::disconnect;
+  throw std::invalid_argument("Unknown websocket overflow policy: " + policy);
+}
+
+Json::Value WSQueueMetrics::toJson() const {
+  Json::Value res;
+  res["queued_messages"] = Json::UInt64(queued_messages.load());
+  res["queued_bytes"] = Json::UInt64(queued_bytes.load());
+  res["dropped_events"] = Json::UInt64(dropped_events.load());
+  res["coalesced_events"] = Json::UInt64(coalesced_events.load());
+  res["disconnected_sessions"] = Json::UInt64(disconnected_sessions.load());
+  return res;
+}
+
+WSSubscriptionEvent::WSSubscriptionEvent(WSSubscription subscription, Json::Value const &result)
+    : subscription(subscription) {
+  // Same layout as Json::FastWriter produces for {"jsonrpc", "method", "params": {"result", "subscription"}}
+  auto encoded_result = Json::FastWriter().write(result);
+  encoded_result.pop_back();  // trailing newline
+  head = R"({"jsonrpc":"2.0","method":"eth_subscription","params":{"result":)" + encoded_result +
+         R"(,"subscription":")";
+  tail = "\"}}\n";
+}
+
+std::array<boost::asio::const_buffer, 3> WSMessage::buffers() const {
+  if (!event) {
+    return {boost::asio::buffer(text), boost::asio::const_buffer(), boost::asio::const_buffer()};
   }
+  return {boost::asio::buffer(event->head), boost::asio::buffer(text), boost::asio::buffer(event->tail)};
 }
 
 void WSSession::close() {
@@ -270,8 +276,13 @@ void WSSession::close() {
   ws_.close("close");
 }
 
-WSServer::WSServer(boost::asio::io_context &ioc, tcp::endpoint endpoint, addr_t node_addr)
-    : ioc_(ioc), acceptor_(ioc), node_addr_(node_addr) {
+WSServer::WSServer(boost::asio::io_context &ioc, tcp::endpoint endpoint, addr_t node_addr,
+                   WSQueueLimits const &queue_limits)
+    : ioc_(ioc),
+      events_strand_(boost::asio::make_strand(ioc)),
+      acceptor_(ioc),
+      node_addr_(node_addr),
+      queue_limits_(queue_limits) {
   LOG_OBJECTS_CREATE("RPC");
   beast::error_code ec;
 
@@ -342,7 +353,8 @@ void WSServer::on_accept(beast::error_code ec, tcp::socket socket) {
       }
     }
     // Create the session and run it
-    sessions.push_back(std::make_shared<WSSession>(std::move(socket), node_addr_, shared_from_this()));
+    sessions.push_back(std::make_shared<WSSession>(std::move(socket), node_addr_, shared_from_this(), queue_limits_,
+                                                  queue_metrics_));
     sessions.back()->run();
   }
 
@@ -350,41 +362,52 @@ void WSServer::on_accept(beast::error_code ec, tcp::socket socket) {
   if (!stopped_) do_accept();
 }
 
+void WSServer::notifySubscribers(WSSubscription subscription, std::function<Json::Value()> make_result) {
+  boost::asio::post(events_strand_, [this, this_sp = shared_from_this(), subscription,
+                                     make_result = std::move(make_result)] {
+    std::vector<std::shared_ptr<WSSession>> subscribers;
+    {
+      boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
+      for (auto const &session : sessions) {
+        if (!session->is_closed() && session->isSubscribed(subscription)) subscribers.push_back(session);
+      }
+    }
+    if (subscribers.empty()) return;
+    auto const event = std::make_shared<WSSubscriptionEvent const>(subscription, make_result());
+    for (auto const &session : subscribers) {
+      session->notify(subscription, event);
+    }
+  });
+}
+
 void WSServer::newDagBlock(DagBlock const &blk) {
-  boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
-  for (auto const &session : sessions) {
-    if (!session->is_closed()) session->newDagBlock(blk);
-  }
+  notifySubscribers(WSSubscription::new_dag_blocks, [blk] { return blk.getJson(); });
 }
 
 void WSServer::newDagBlockFinalized(blk_hash_t const &blk, uint64_t period) {
-  boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
-  for (auto const &session : sessions) {
-    if (!session->is_closed()) session->newDagBlockFinalized(blk, period);
-  }
+  notifySubscribers(WSSubscription::new_dag_blocks_finalized, [blk, period] {
+    Json::Value result;
+    result["block"] = dev::toJS(blk);
+    result["period"] = dev::toJS(period);
+    return result;
+  });
 }
 
 void WSServer::newPbftBlockExecuted(PbftBlock const &pbft_blk,
                                     std::vector<blk_hash_t> const &finalized_dag_blk_hashes) {
-  auto payload = PbftBlock::toJson(pbft_blk, finalized_dag_blk_hashes);
-  boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
-  for (auto const &session : sessions) {
-    if (!session->is_closed()) session->newPbftBlockExecuted(payload);
-  }
+  notifySubscribers(WSSubscription::new_pbft_blocks, [pbft_blk, finalized_dag_blk_hashes] {
+    Json::Value result;
+    result["pbft_block"] = PbftBlock::toJson(pbft_blk, finalized_dag_blk_hashes);
+    return result;
+  });
 }
 
 void WSServer::newEthBlock(dev::eth::BlockHeader const &payload) {
-  boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
-  for (auto const &session : sessions) {
-    if (!session->is_closed()) session->newEthBlock(payload);
-  }
+  notifySubscribers(WSSubscription::new_heads, [payload] { return dev::eth::toJson(payload); });
 }
 
 void WSServer::newPendingTransaction(trx_hash_t const &trx_hash) {
-  boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
-  for (auto const &session : sessions) {
-    if (!session->is_closed()) session->newPendingTransaction(trx_hash);
-  }
+  notifySubscribers(WSSubscription::new_pending_transactions, [trx_hash] { return Json::Value(dev::toJS(trx_hash)); });
 }
 
 }  // namespace taraxa::net
\ No newline at end of file
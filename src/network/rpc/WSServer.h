@@ -1,9 +1,11 @@
 #pragma once
 
+#include <json/json.h>
 #include <jsonrpccpp/server/abstractserverconnector.h>
 #include <libethcore/BlockHeader.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
@@ -12,6 +14,7 @@
 #include <deque>
 #include <functional>
 #include <iostream>
+#include <list>
 #include <memory>
 #include <string>
 #include <thread>
@@ -28,15 +31,72 @@ namespace http = beast::http;            // from <boost/beast/http.hpp>
 namespace websocket = beast::websocket;  // from <boost/beast/websocket.hpp>
 using tcp = boost::asio::ip::tcp;        // from <boost/asio/ip/tcp.hpp>
 
+enum class WSSubscription : uint8_t {
+  new_heads = 0,
+  new_pending_transactions,
+  new_dag_blocks,
+  new_dag_blocks_finalized,
+  new_pbft_blocks
+};
+constexpr size_t c_ws_subscriptions_count = 5;
+
+// What a session does with a subscription event which doesn't fit into its full outbound queue:
+// drop_oldest - oldest queued events are dropped to make room
+// coalesce - queued event of the same subscription is replaced by the new one (e.g. only the latest head is kept),
+//            falls back to drop_oldest if there is no such event
+// disconnect - session is closed
+enum class WSOverflowPolicy : uint8_t { drop_oldest, coalesce, disconnect };
+WSOverflowPolicy wsOverflowPolicyFromString(std::string const& policy);
+
+struct WSQueueLimits {
+  // Max number of messages queued per session, the policy is applied when it's reached
+  size_t max_queue_size = 1000;
+  // Max number of bytes queued by all the sessions together, events which would exceed it are dropped
+  uint64_t max_queued_bytes = 64 * 1024 * 1024;
+  WSOverflowPolicy overflow_policy = WSOverflowPolicy::drop_oldest;
+};
+
+// Outbound queues accounting shared by all the sessions of a server
+struct WSQueueMetrics {
+  std::atomic<uint64_t> queued_messages = 0;
+  std::atomic<uint64_t> queued_bytes = 0;
+  std::atomic<uint64_t> dropped_events = 0;
+  std::atomic<uint64_t> coalesced_events = 0;
+  std::atomic<uint64_t> disconnected_sessions = 0;
+
+  Json::Value toJson() const;
+};
+
+// Subscription notification serialized once and shared by all the subscribed sessions, a session only splices its
+// subscription id in between head and tail
+struct WSSubscriptionEvent {
+  WSSubscriptionEvent(WSSubscription subscription, Json::Value const& result);
+
+  WSSubscription const subscription;
+  std::string head;
+  std::string tail;
+};
+
+// Queued outgoing message, either a plain response or a shared event with session's subscription id
+struct WSMessage {
+  std::shared_ptr<WSSubscriptionEvent const> event;
+  std::string text;
+
+  std::array<boost::asio::const_buffer, 3> buffers() const;
+  size_t size() const { return text.size() + (event ? event->head.size() + event->tail.size() : 0); }
+};
+
 class WSServer;
 class WSSession : public std::enable_shared_from_this<WSSession> {
  public:
   // Take ownership of the socket
-  explicit WSSession(tcp::socket&& socket, addr_t node_addr, std::shared_ptr<WSServer> ws_server)
-      : ws_(std::move(socket)) {
+  explicit WSSession(tcp::socket&& socket, addr_t node_addr, std::shared_ptr<WSServer> ws_server,
+                     WSQueueLimits const& queue_limits, std::shared_ptr<WSQueueMetrics> queue_metrics)
+      : ws_(std::move(socket)), queue_limits_(queue_limits), queue_metrics_(std::move(queue_metrics)) {
     LOG_OBJECTS_CREATE("RPC");
     ws_server_ = ws_server;
   }
+  ~WSSession();
 
   // Start the asynchronous operation
   void run();
@@ -47,28 +107,32 @@ class WSSession : public std::enable_shared_from_this<WSSession> {
   void on_read(beast::error_code ec, std::size_t bytes_transferred);
   void on_write(beast::error_code ec, std::size_t bytes_transferred);
   void on_write_no_read(beast::error_code ec, std::size_t bytes_transferred);
-  void newEthBlock(dev::eth::BlockHeader const& payload);
-  void newDagBlock(DagBlock const& blk);
-  void newDagBlockFinalized(blk_hash_t const& blk, uint64_t period);
-  void newPbftBlockExecuted(Json::Value const& payload);
-  void newPendingTransaction(trx_hash_t const& trx_hash);
+  bool isSubscribed(WSSubscription subscription) const {
+    return subscriptions_[static_cast<size_t>(subscription)] != 0;
+  }
+  // Queues the event to be sent, called from WSServer while the actual write happens on the session's strand
+  void notify(WSSubscription subscription, std::shared_ptr<WSSubscriptionEvent const> const& event);
   bool is_closed() { return closed_; }
   LOG_OBJECTS_DEFINE;
 
  private:
-  void writeImpl(const std::string& message);
-  void write(const std::string& message);
-  std::deque<std::string> queue_messages_;
+  void post(WSMessage message);
+  void writeImpl(WSMessage message);
+  void write();
+  // Applies overflow policy to make room for the message, returns false if it should not be queued
+  bool makeRoom(WSMessage const& message);
+  void dequeue(std::deque<WSMessage>::iterator it);
+  void disconnect();
+  // Written message is kept at the front until the write completes
+  std::deque<WSMessage> queue_messages_;
   websocket::stream<beast::tcp_stream> ws_;
   beast::flat_buffer buffer_;
-  std::string write_buffer_;
   int subscription_id_ = 0;
-  int new_heads_subscription_ = 0;
-  int new_dag_blocks_subscription_ = 0;
-  int new_transactions_subscription_ = 0;
-  int new_dag_block_finalized_subscription_ = 0;
-  int new_pbft_block_executed_subscription_ = 0;
+  // Subscription ids per WSSubscription, 0 when not subscribed
+  std::array<std::atomic<int>, c_ws_subscriptions_count> subscriptions_{};
   std::atomic<bool> closed_ = false;
+  WSQueueLimits const queue_limits_;
+  std::shared_ptr<WSQueueMetrics> const queue_metrics_;
   std::weak_ptr<WSServer> ws_server_;
 };
 
@@ -77,7 +141,8 @@ class WSSession : public std::enable_shared_from_this<WSSession> {
 // Accepts incoming connections and launches the sessions
 class WSServer : public std::enable_shared_from_this<WSServer>, public jsonrpc::AbstractServerConnector {
  public:
-  WSServer(boost::asio::io_context& ioc, tcp::endpoint endpoint, addr_t node_addr);
+  WSServer(boost::asio::io_context& ioc, tcp::endpoint endpoint, addr_t node_addr,
+           WSQueueLimits const& queue_limits = {});
   ~WSServer();
 
   // Start accepting incoming connections
@@ -87,6 +152,7 @@ class WSServer : public std::enable_shared_from_this<WSServer>, public jsonrpc::
   void newDagBlockFinalized(blk_hash_t const& blk, uint64_t period);
   void newPbftBlockExecuted(PbftBlock const& sche_blk, std::vector<blk_hash_t> const& finalized_dag_blk_hashes);
   void newPendingTransaction(trx_hash_t const& trx_hash);
+  WSQueueMetrics const& getQueueMetrics() const { return *queue_metrics_; }
 
   virtual bool StartListening() { return true; };
   virtual bool StopListening() { return true; };
@@ -95,13 +161,19 @@ class WSServer : public std::enable_shared_from_this<WSServer>, public jsonrpc::
  private:
   void do_accept();
   void on_accept(beast::error_code ec, tcp::socket socket);
+  // Serializes the event once (only if somebody is subscribed) and queues it to the subscribed sessions. Runs on
+  // events_strand_ so callers never wait for it and events are delivered in the order they were emitted
+  void notifySubscribers(WSSubscription subscription, std::function<Json::Value()> make_result);
   LOG_OBJECTS_DEFINE;
   boost::asio::io_context& ioc_;
+  boost::asio::strand<boost::asio::io_context::executor_type> events_strand_;
   tcp::acceptor acceptor_;
   std::list<std::shared_ptr<WSSession>> sessions;
   std::atomic<bool> stopped_ = false;
   boost::shared_mutex sessions_mtx_;
   addr_t node_addr_;
+  WSQueueLimits const queue_limits_;
+  std::shared_ptr<WSQueueMetrics> const queue_metrics_ = std::make_shared<WSQueueMetrics>();
 };
 
 }  // namespace taraxa::net
@@ -30,7 +30,7 @@ void TaraxaCapability::erasePeer(NodeID const &node_id) {
 
 void TaraxaCapability::insertPeer(NodeID const &node_id, std::shared_ptr<TaraxaPeer> const &peer) {
   boost::unique_lock<boost::shared_mutex> lock(peers_mutex_);
-  peers_.emplace(std::make_pair(node_id, std::make_shared<TaraxaPeer>(node_id)));
+  peers_.emplace(std::make_pair(node_id, peer));
 }
 
 void TaraxaCapability::syncPeerPbft(NodeID const &_nodeID, unsigned long height_to_sync) {
@@ -74,46 +74,19 @@ void TaraxaCapability::onConnect(NodeID const &_nodeID, u256 const &) {
   cnt_received_messages_[_nodeID] = 0;
   test_sums_[_nodeID] = 0;
 
-  insertPeer(_nodeID, std::make_shared<TaraxaPeer>(_nodeID));
+  metrics_.addPeer(_nodeID);
+  auto peer = std::make_shared<TaraxaPeer>(_nodeID, conf_.network_known_items_false_positive_rate,
+                                           std::chrono::milliseconds(conf_.network_known_items_max_age));
+  insertPeer(_nodeID, peer);
   sendStatus(_nodeID, true);
+  queueVerifiedTransactions(_nodeID, peer);
 }
 
 bool TaraxaCapability::interpretCapabilityPacket(NodeID const &_nodeID, unsigned _id, RLP const &_r) {
   if (stopped_) return true;
+  metrics_.onReceived(_nodeID, _id, _r.actualSize());
   if (conf_.network_simulated_delay == 0) {
-    if (performance_log_) {
-      static std::map<unsigned, std::pair<uint32_t, uint64_t>> perf_data;
-      static std::chrono::steady_clock::time_point begin_perf = std::chrono::steady_clock::now();
-      std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-      LOG(log_dg_net_per_) << packetToPacketName(_id) << " received";
-      auto ret = interpretCapabilityPacketImpl(_nodeID, _id, _r);
-      std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-      auto dur = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
-      if (dur > 100000) {
-        LOG(log_nf_net_per_) << packetToPacketName(_id) << " processed in: " << dur << "[µs]";
-      } else {
-        LOG(log_dg_net_per_) << packetToPacketName(_id) << " processed in: " << dur << "[µs]";
-      }
-      perf_data[_id].first++;
-      perf_data[_id].second += dur;
-      if (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - begin_perf).count() >
-          20) {
-        uint32_t total_count = 0;
-        uint64_t total_time = 0;
-        for (auto const &it : perf_data) {
-          total_count += it.second.first;
-          total_time += it.second.second;
-          LOG(log_nf_net_per_) << packetToPacketName(it.first) << " No: " << it.second.first
-                               << " - Avg time: " << it.second.second / it.second.first << "[µs]";
-        }
-        LOG(log_nf_net_per_) << "All packets"
-                             << " No: " << total_count << " - Avg time: " << total_time / total_count << "[µs]";
-        begin_perf = end;
-      }
-
-      return ret;
-    } else
-      return interpretCapabilityPacketImpl(_nodeID, _id, _r);
+    return handlePacket(_nodeID, _id, _r);
   }
   // RLP contains memory it does not own so deep copy of bytes is needed
   dev::bytes rBytes = _r.data().toBytes();
@@ -132,27 +105,67 @@ bool TaraxaCapability::interpretCapabilityPacket(NodeID const &_nodeID, unsigned
                << " milliseconds";
   auto timer = std::make_shared<boost::asio::deadline_timer>(io_service_);
   timer->expires_from_now(boost::posix_time::milliseconds(total_delay));
-  timer->async_wait(([this, _nodeID, _id, rBytes, timer](const boost::system::error_code &ec) {
+  auto const received_at = std::chrono::steady_clock::now();
+  timer->async_wait(([this, _nodeID, _id, rBytes, timer, received_at](const boost::system::error_code &ec) {
+    metrics_.packet(_id).queue_wait.observeSince(received_at);
     RLP _rCopy(rBytes);
-    interpretCapabilityPacketImpl(_nodeID, _id, _rCopy);
+    handlePacket(_nodeID, _id, _rCopy);
   }));
   return true;
 }
 
+bool TaraxaCapability::handlePacket(NodeID const &_nodeID, unsigned _id, RLP const &_r) {
+  auto const begin = std::chrono::steady_clock::now();
+  if (performance_log_) {
+    LOG(log_dg_net_per_) << packetToPacketName(_id) << " received";
+  }
+  auto ret = interpretCapabilityPacketImpl(_nodeID, _id, _r);
+  auto const end = std::chrono::steady_clock::now();
+  auto const dur = std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+  metrics_.onHandled(_nodeID, _id, dur);
+  if (performance_log_) {
+    if (dur.count() > 100000) {
+      LOG(log_nf_net_per_) << packetToPacketName(_id) << " processed in: " << dur.count() << "[µs]";
+    } else {
+      LOG(log_dg_net_per_) << packetToPacketName(_id) << " processed in: " << dur.count() << "[µs]";
+    }
+    // Periodical summary, packets may be handled by multiple threads (simulated delay) so only one of them logs it
+    auto perf_log_begin = perf_log_begin_.load();
+    if (std::chrono::duration_cast<std::chrono::seconds>(end - perf_log_begin).count() > 20 &&
+        perf_log_begin_.compare_exchange_strong(perf_log_begin, end)) {
+      uint64_t total_count = 0;
+      uint64_t total_time = 0;
+      for (uint8_t it = 0; it != PacketCount; it++) {
+        auto const &handler = metrics_.packet(it).handler;
+        if (handler.count() == 0) continue;
+        total_count += handler.count();
+        total_time += handler.sumUs();
+        LOG(log_nf_net_per_) << packetToPacketName(it) << " No: " << handler.count()
+                             << " - Avg time: " << handler.sumUs() / handler.count() << "[µs]";
+      }
+      if (total_count > 0) {
+        LOG(log_nf_net_per_) << "All packets"
+                             << " No: " << total_count << " - Avg time: " << total_time / total_count << "[µs]";
+      }
+    }
+  }
+  return ret;
+}
+
 bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsigned _id, RLP const &_r) {
   try {
     auto peer = getPeer(_nodeID);
     if (peer) {
-      packet_size[_id] += _r.actualSize();
-      packet_count[_id]++;
       switch (_id) {
         case SyncedPacket: {
           LOG(log_dg_dag_sync_) << "Received synced message from " << _nodeID;
           peer->syncing_ = false;
           peer->clearAllKnownBlocksAndTransactions();
+          queueVerifiedTransactions(_nodeID, peer);
         } break;
         case StatusPacket: {
           peer->statusReceived();
+          bool const was_syncing = peer->syncing_;
           bool initial_status = _r.itemCount() == 9;
           uint64_t peer_level;
           uint64_t peer_pbft_chain_size;
@@ -231,6 +244,8 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
               // not synced, force a switch to a new node
               restartSyncingPbft(true);
             }
+          } else if (was_syncing) {
+            queueVerifiedTransactions(_nodeID, peer);
           }
 
           break;
@@ -238,6 +253,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
         // Means a new block is proposed, full block body and all transaction
         // are received.
         case NewBlockPacket: {
+          auto const decode_begin = std::chrono::steady_clock::now();
           DagBlock block(_r[0].data().toBytes());
 
           if (dag_blk_mgr_) {
@@ -246,7 +262,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
               break;
             }
           }
-          unique_packet_count[_id]++;
+          ++metrics_.packet(_id).unique_in;
 
           auto transactionsCount = _r.itemCount() - 1;
           LOG(log_dg_dag_prp_) << "Received NewBlockPacket " << transactionsCount;
@@ -257,6 +273,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
             newTransactions.push_back(transaction);
             peer->markTransactionAsKnown(transaction.getHash());
           }
+          metrics_.packet(_id).decode.observeSince(decode_begin);
 
           peer->markBlockAsKnown(block.getHash());
           if (block.getLevel() > peer->dag_level_) peer->dag_level_ = block.getLevel();
@@ -270,7 +287,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
           peer->markBlockAsKnown(hash);
           if (dag_blk_mgr_) {
             if (!dag_blk_mgr_->isBlockKnown(hash) && block_requestes_set_.count(hash) == 0) {
-              unique_packet_count[_id]++;
+              ++metrics_.packet(_id).unique_in;
               block_requestes_set_.insert(hash);
               requestBlock(_nodeID, hash);
             }
@@ -345,6 +362,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
           break;
         }
         case TransactionPacket: {
+          auto const decode_begin = std::chrono::steady_clock::now();
           std::string receivedTransactions;
           std::vector<taraxa::bytes> transactions;
           auto transactionCount = _r.itemCount();
@@ -354,6 +372,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
             peer->markTransactionAsKnown(transaction.getHash());
             transactions.emplace_back(_r[iTransaction].data().toBytes());
           }
+          metrics_.packet(_id).decode.observeSince(decode_begin);
           if (transactionCount > 0) {
             LOG(log_dg_trx_prp_) << "Received TransactionPacket with " << _r.itemCount() << " transactions";
             LOG(log_tr_trx_prp_) << "Received TransactionPacket with " << _r.itemCount()
@@ -366,12 +385,14 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
         case PbftVotePacket: {
           LOG(log_dg_vote_prp_) << "In PbftVotePacket";
 
+          auto const decode_begin = std::chrono::steady_clock::now();
           Vote vote(_r[0].toBytes());
+          metrics_.packet(_id).decode.observeSince(decode_begin);
           LOG(log_dg_vote_prp_) << "Received PBFT vote " << vote.getHash();
           peer->markVoteAsKnown(vote.getHash());
 
           if (vote_mgr_->addVote(vote)) {
-            unique_packet_count[_id]++;
+            ++metrics_.packet(_id).unique_in;
             onNewPbftVote(vote);
           }
           break;
@@ -414,8 +435,10 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
         case NewPbftBlockPacket: {
           LOG(log_dg_pbft_prp_) << "In NewPbftBlockPacket";
 
+          auto const decode_begin = std::chrono::steady_clock::now();
           auto pbft_block = s_ptr(new PbftBlock(_r[0]));
           uint64_t pbft_chain_size = _r[1].toInt();
+          metrics_.packet(_id).decode.observeSince(decode_begin);
           LOG(log_dg_pbft_prp_) << "Receive proposed PBFT Block " << pbft_block
                                 << " Peer Chain size: " << pbft_chain_size;
           peer->markPbftBlockAsKnown(pbft_block->getBlockHash());
@@ -425,7 +448,7 @@ bool TaraxaCapability::interpretCapabilityPacketImpl(NodeID const &_nodeID, unsi
             // TODO: need to check block validation, like proposed
             // vote(maybe
             //  come later), if get sortition etc
-            unique_packet_count[_id]++;
+            ++metrics_.packet(_id).unique_in;
             pbft_chain_->pushUnverifiedPbftBlock(pbft_block);
             onNewPbftBlock(*pbft_block);
           }
@@ -554,7 +577,7 @@ void TaraxaCapability::delayedPbftSync(NodeID _nodeID, int counter) {
       LOG(log_er_pbft_sync_) << "Pbft blocks stuck in queue, no new block processed "
                                 "in 60 seconds "
                              << pbft_sync_period_ << " " << pbft_chain_->getPbftChainSize();
-      syncing_ = false;
+      setSyncing(false);
       LOG(log_dg_pbft_sync_) << "Syncing PBFT is stopping";
       return;
     }
@@ -570,6 +593,14 @@ void TaraxaCapability::delayedPbftSync(NodeID _nodeID, int counter) {
   }
 }
 
+void TaraxaCapability::setSyncing(bool syncing) {
+  if (syncing_ == syncing) {
+    return;
+  }
+  syncing_ = syncing;
+  event_syncing_changed.pub(syncing);
+}
+
 void TaraxaCapability::restartSyncingPbft(bool force) {
   if (stopped_) return;
   if (syncing_ && !force) {
@@ -599,7 +630,7 @@ void TaraxaCapability::restartSyncingPbft(bool force) {
     if (!stopped_) {
       LOG(log_si_pbft_sync_) << "Restarting syncing PBFT" << max_pbft_chain_size << " " << pbft_sync_period_;
       requesting_pending_dag_blocks_ = false;
-      syncing_ = true;
+      setSyncing(true);
       peer_syncing_pbft = max_pbft_chain_nodeID;
       peer_syncing_pbft_chain_size_ = max_pbft_chain_size;
       syncPeerPbft(peer_syncing_pbft, pbft_sync_period_ + 1);
@@ -609,7 +640,7 @@ void TaraxaCapability::restartSyncingPbft(bool force) {
                               "size: "
                            << pbft_sync_period_ << "(" << pbft_chain_->getPbftChainSize() << ")"
                            << " is greater or equal than max node pbft chain size:" << max_pbft_chain_size;
-    syncing_ = false;
+    setSyncing(false);
     if (!requesting_pending_dag_blocks_ &&
         (force || max_node_dag_level > std::max(dag_mgr_->getMaxLevel(), dag_blk_mgr_->getMaxDagLevelInQueue()))) {
       LOG(log_nf_dag_sync_) << "Request pending " << max_node_dag_level << " "
@@ -627,6 +658,7 @@ void TaraxaCapability::onDisconnect(NodeID const &_nodeID) {
   cnt_received_messages_.erase(_nodeID);
   test_sums_.erase(_nodeID);
   erasePeer(_nodeID);
+  metrics_.removePeer(_nodeID);
   if (syncing_ && peer_syncing_pbft == _nodeID && getPeersCount() > 0) {
     LOG(log_dg_pbft_sync_) << "Syncing PBFT is stopping";
     restartSyncingPbft(true);
@@ -637,9 +669,14 @@ void TaraxaCapability::onDisconnect(NodeID const &_nodeID) {
   }
 }
 
+void TaraxaCapability::sealAndSend(NodeID const &_id, unsigned _packet_type, RLPStream &_s) {
+  metrics_.onSent(_id, _packet_type, _s.out().size());
+  host_.capabilityHost()->sealAndSend(_id, _s);
+}
+
 void TaraxaCapability::sendTestMessage(NodeID const &_id, int _x) {
   RLPStream s;
-  host_.capabilityHost()->sealAndSend(_id, host_.capabilityHost()->prep(_id, name(), s, TestPacket, 1) << _x);
+  sealAndSend(_id, TestPacket, host_.capabilityHost()->prep(_id, name(), s, TestPacket, 1) << _x);
 }
 
 void TaraxaCapability::sendStatus(NodeID const &_id, bool _initial) {
@@ -658,14 +695,15 @@ void TaraxaCapability::sendStatus(NodeID const &_id, bool _initial) {
     LOG(log_dg_pbft_sync_) << "Sending status message to " << _id << " with pbft chain size: " << pbft_chain_size;
     LOG(log_dg_next_votes_sync_) << "Sending status message to " << _id << " with PBFT round: " << pbft_round;
     if (_initial) {
-      host_.capabilityHost()->sealAndSend(_id, host_.capabilityHost()->prep(_id, name(), s, StatusPacket, 9)
-                                                   << FullNode::c_network_protocol_version << conf_.network_id
-                                                   << dag_max_level << genesis_ << pbft_chain_size << syncing_
-                                                   << pbft_round << FullNode::c_node_major_version
-                                                   << FullNode::c_node_minor_version);
+      sealAndSend(_id, StatusPacket,
+                  host_.capabilityHost()->prep(_id, name(), s, StatusPacket, 9)
+                      << FullNode::c_network_protocol_version << conf_.network_id << dag_max_level << genesis_
+                      << pbft_chain_size << syncing_ << pbft_round << FullNode::c_node_major_version
+                      << FullNode::c_node_minor_version);
     } else {
-      host_.capabilityHost()->sealAndSend(_id, host_.capabilityHost()->prep(_id, name(), s, StatusPacket, 4)
-                                                   << dag_max_level << pbft_chain_size << syncing_ << pbft_round);
+      sealAndSend(_id, StatusPacket,
+                  host_.capabilityHost()->prep(_id, name(), s, StatusPacket, 4)
+                      << dag_max_level << pbft_chain_size << syncing_ << pbft_round);
     }
   }
 }
@@ -724,33 +762,80 @@ void TaraxaCapability::onNewTransactions(std::vector<taraxa::bytes> const &trans
     }
   }
   if (!fromNetwork || conf_.network_transaction_interval == 0) {
-    std::map<NodeID, std::vector<taraxa::bytes>> transactionsToSend;
-    std::map<NodeID, std::vector<trx_hash_t>> transactionsHashToSend;
+    // Decode every transaction only once, the encoded bytes are shared by all peer queues
+    std::vector<std::pair<trx_hash_t, std::shared_ptr<taraxa::bytes const>>> new_transactions;
+    new_transactions.reserve(transactions.size());
+    for (auto const &transaction : transactions) {
+      new_transactions.emplace_back(Transaction(transaction).getHash(), std::make_shared<taraxa::bytes>(transaction));
+    }
+
+    std::vector<std::pair<NodeID, std::shared_ptr<TaraxaPeer>>> peers_to_flush;
     {
-      boost::unique_lock<boost::shared_mutex> lock(peers_mutex_);
-      for (auto &peer : peers_) {
-        if (!peer.second->syncing_) {
-          for (auto const &transaction : transactions) {
-            Transaction trx(transaction);
-            auto trx_hash = trx.getHash();
-            if (!peer.second->isTransactionKnown(trx_hash)) {
-              transactionsToSend[peer.first].push_back(transaction);
-              transactionsHashToSend[peer.first].push_back(trx_hash);
-            }
+      boost::shared_lock<boost::shared_mutex> lock(peers_mutex_);
+      for (auto const &peer : peers_) {
+        if (peer.second->syncing_) {
+          continue;
+        }
+        size_t queued_size = 0;
+        for (auto const &[trx_hash, trx_bytes] : new_transactions) {
+          if (peer.second->markTransactionAsKnownIfNew(trx_hash)) {
+            queued_size = peer.second->queueTransaction(trx_bytes);
           }
         }
+        // Without transaction interval there is no periodic flush, send right away
+        if (queued_size > 0 &&
+            (conf_.network_transaction_interval == 0 || queued_size >= conf_.network_transaction_max_packet_size)) {
+          peers_to_flush.emplace_back(peer);
+        }
       }
     }
-    for (auto &it : transactionsToSend) {
-      sendTransactions(it.first, it.second);
+    for (auto const &peer : peers_to_flush) {
+      sendQueuedTransactions(peer.first, peer.second);
     }
-    boost::unique_lock<boost::shared_mutex> lock(peers_mutex_);
-    for (auto &it : transactionsHashToSend) {
-      for (auto &it2 : it.second) {
-        peers_[it.first]->markTransactionAsKnown(it2);
-      }
+  }
+}
+
+void TaraxaCapability::queueVerifiedTransactions(NodeID const &_id, std::shared_ptr<TaraxaPeer> const &peer) {
+  if (!trx_mgr_) {
+    return;
+  }
+  size_t queued_size = 0;
+  for (auto const &trx : trx_mgr_->getVerifiedTrxSnapShotSorted()) {
+    if (peer->markTransactionAsKnownIfNew(trx.getHash())) {
+      queued_size = peer->queueTransaction(trx.rlp());
     }
   }
+  if (queued_size > 0 &&
+      (conf_.network_transaction_interval == 0 || queued_size >= conf_.network_transaction_max_packet_size)) {
+    sendQueuedTransactions(_id, peer);
+  }
+}
+
+void TaraxaCapability::sendQueuedTransactions(NodeID const &_id, std::shared_ptr<TaraxaPeer> const &peer) {
+  std::chrono::steady_clock::time_point queued_since;
+  auto const transactions = peer->takeQueuedTransactions(queued_since);
+  if (!transactions.empty()) {
+    metrics_.packet(TransactionPacket).queue_wait.observeSince(queued_since);
+  }
+  auto it = transactions.begin();
+  while (it != transactions.end()) {
+    // Split queued transactions into packets that fit the packet size budget, at least one transaction per packet
+    auto packet_begin = it;
+    size_t packet_size = 0;
+    taraxa::bytes trx_bytes;
+    do {
+      packet_size += (*it)->size();
+      trx_bytes.insert(trx_bytes.end(), (*it)->begin(), (*it)->end());
+      ++it;
+    } while (it != transactions.end() && packet_size + (*it)->size() <= conf_.network_transaction_max_packet_size);
+
+    auto const transactions_count = std::distance(packet_begin, it);
+    LOG(log_nf_trx_prp_) << "sendTransactions " << transactions_count << " to " << _id;
+    RLPStream s;
+    host_.capabilityHost()->prep(_id, name(), s, TransactionPacket, transactions_count);
+    s.appendRaw(trx_bytes, transactions_count);
+    sealAndSend(_id, TransactionPacket, s);
+  }
 }
 
 void TaraxaCapability::onNewBlockReceived(DagBlock block, std::vector<Transaction> transactions) {
@@ -783,7 +868,7 @@ void TaraxaCapability::sendSyncedMessage() {
   for (auto &peer : getAllPeers()) {
     RLPStream s;
     host_.capabilityHost()->prep(peer, name(), s, SyncedPacket, 0);
-    host_.capabilityHost()->sealAndSend(peer, s);
+    sealAndSend(peer, SyncedPacket, s);
   }
 }
 
@@ -859,7 +944,7 @@ void TaraxaCapability::sendBlocks(NodeID const &_id, std::vector<std::shared_ptr
     }
     s.appendRaw(trx_bytes, blockTransactions[block->getHash()].size());
   }
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, BlocksPacket, s);
 }
 
 void TaraxaCapability::sendTransactions(NodeID const &_id, std::vector<taraxa::bytes> const &transactions) {
@@ -871,7 +956,7 @@ void TaraxaCapability::sendTransactions(NodeID const &_id, std::vector<taraxa::b
     trx_bytes.insert(trx_bytes.end(), std::begin(transaction), std::end(transaction));
   }
   s.appendRaw(trx_bytes, transactions.size());
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, TransactionPacket, s);
 }
 
 void TaraxaCapability::sendBlock(NodeID const &_id, taraxa::DagBlock block) {
@@ -899,7 +984,7 @@ void TaraxaCapability::sendBlock(NodeID const &_id, taraxa::DagBlock block) {
     trx_bytes.insert(trx_bytes.end(), std::begin(transaction->second), std::end(transaction->second));
   }
   s.appendRaw(trx_bytes, transactionsToSend.size());
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, NewBlockPacket, s);
   LOG(log_dg_dag_prp_) << "Send DagBlock " << block.getHash() << " #Trx: " << transactionsToSend.size() << std::endl;
 }
 
@@ -908,7 +993,7 @@ void TaraxaCapability::sendBlockHash(NodeID const &_id, taraxa::DagBlock block)
   RLPStream s;
   host_.capabilityHost()->prep(_id, name(), s, NewBlockHashPacket, 1);
   s.append(block.getHash());
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, NewBlockHashPacket, s);
 }
 
 void TaraxaCapability::requestBlock(NodeID const &_id, blk_hash_t hash) {
@@ -916,7 +1001,7 @@ void TaraxaCapability::requestBlock(NodeID const &_id, blk_hash_t hash) {
   RLPStream s;
   host_.capabilityHost()->prep(_id, name(), s, GetNewBlockPacket, 1);
   s.append(hash);
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, GetNewBlockPacket, s);
 }
 
 void TaraxaCapability::requestPbftBlocks(NodeID const &_id, size_t height_to_sync) {
@@ -924,14 +1009,14 @@ void TaraxaCapability::requestPbftBlocks(NodeID const &_id, size_t height_to_syn
   host_.capabilityHost()->prep(_id, name(), s, GetPbftBlockPacket, 1);
   s << height_to_sync;
   LOG(log_dg_pbft_sync_) << "Sending GetPbftBlockPacket with height: " << height_to_sync;
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, GetPbftBlockPacket, s);
 }
 
 void TaraxaCapability::requestPendingDagBlocks(NodeID const &_id) {
   RLPStream s;
   host_.capabilityHost()->prep(_id, name(), s, GetBlocksPacket, 0);
   LOG(log_nf_dag_sync_) << "Sending GetBlocksPacket";
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, GetBlocksPacket, s);
 }
 
 std::pair<int, int> TaraxaCapability::retrieveTestData(NodeID const &_id) {
@@ -953,6 +1038,14 @@ std::map<trx_hash_t, taraxa::Transaction> TaraxaCapability::getTransactions() {
 void TaraxaCapability::sendTransactions() {
   if (trx_mgr_) {
     onNewTransactions(trx_mgr_->getNewVerifiedTrxSnapShotSerialized(), false);
+    std::vector<std::pair<NodeID, std::shared_ptr<TaraxaPeer>>> peers;
+    {
+      boost::shared_lock<boost::shared_mutex> lock(peers_mutex_);
+      peers.assign(peers_.begin(), peers_.end());
+    }
+    for (auto const &peer : peers) {
+      sendQueuedTransactions(peer.first, peer.second);
+    }
     host_.scheduleExecution(conf_.network_transaction_interval, [this]() { sendTransactions(); });
   }
 }
@@ -983,6 +1076,19 @@ void TaraxaCapability::onStarting() {
     host_.scheduleExecution(conf_.network_transaction_interval, [this]() { sendTransactions(); });
   check_status_interval_ = 6 * lambda_ms_min_;
   host_.scheduleExecution(check_status_interval_, [this]() { doBackgroundWork(); });
+  if (!conf_.network_metrics_file.empty()) {
+    host_.scheduleExecution(conf_.network_metrics_dump_interval, [this]() { dumpMetrics(); });
+  }
+}
+
+void TaraxaCapability::dumpMetrics() {
+  if (stopped_) return;
+  try {
+    metrics_.dumpPrometheus(conf_.network_metrics_file);
+  } catch (std::exception const &e) {
+    LOG(log_er_) << "Failed to dump network metrics to " << conf_.network_metrics_file << ": " << e.what();
+  }
+  host_.scheduleExecution(conf_.network_metrics_dump_interval, [this]() { dumpMetrics(); });
 }
 
 void TaraxaCapability::onNewPbftVote(taraxa::Vote const &vote) {
@@ -1007,7 +1113,7 @@ void TaraxaCapability::sendPbftVote(NodeID const &_id, taraxa::Vote const &vote)
   RLPStream s;
   host_.capabilityHost()->prep(_id, name(), s, PbftVotePacket, 1);
   s.append(vote_rlp);
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, PbftVotePacket, s);
 }
 
 void TaraxaCapability::onNewPbftBlock(taraxa::PbftBlock const &pbft_block) {
@@ -1027,18 +1133,7 @@ void TaraxaCapability::onNewPbftBlock(taraxa::PbftBlock const &pbft_block) {
 }
 
 // api for pbft syncing
-void TaraxaCapability::sendPbftBlocks(NodeID const &_id, size_t height_to_sync, size_t blocks_to_transfer) {
-  LOG(log_dg_pbft_sync_) << "In sendPbftBlocks, peer want to sync from pbft chain height " << height_to_sync
-                         << ", will send at most " << blocks_to_transfer << " pbft blocks to " << _id;
-  auto pbft_cert_blks = pbft_chain_->getPbftBlocks(height_to_sync, blocks_to_transfer);
-  RLPStream s;
-  host_.capabilityHost()->prep(_id, name(), s, PbftBlockPacket, pbft_cert_blks.size());
-  if (pbft_cert_blks.empty()) {
-    host_.capabilityHost()->sealAndSend(_id, s);
-    LOG(log_dg_pbft_sync_) << "In sendPbftBlocks, sent no pbft blocks to " << _id;
-    return;
-  }
-
+void TaraxaCapability::encodePbftBlocks(std::vector<PbftBlockCert> const &pbft_cert_blks, RLPStream &s) {
   // Example actual structure:
   // pbft_blk_1 -> [dag_blk_1, dag_blk_2]
   // pbft_blk_2 -> [dag_blk_3]
@@ -1058,28 +1153,34 @@ void TaraxaCapability::sendPbftBlocks(NodeID const &_id, size_t height_to_sync,
   // level_`k`[i] is parent of level_`k+1` elements with ordinals in range from (inclusive) edges_`k`_to_`k+1`[i] to
   // (exclusive) edges_`k`_to_`k+1`[i+1]
 
+  // Values are read as slices pinned in rocksdb memory and appended straight into the output stream, keys of the
+  // next level point into the pinned values of the previous one, nothing is copied or decoded into vectors.
   DbStorage::MultiGetQuery db_query(db_);
   auto const &level_0 = pbft_cert_blks;
   for (auto const &b : level_0) {
     db_query.append(DbStorage::Columns::dag_finalized_blocks, b.pbft_blk->getPivotDagBlockHash(), false);
   }
-  auto level_0_extra = db_query.execute();
+  auto level_0_extra = db_query.execute_pinned();
   vector<uint> edges_0_to_1;
   edges_0_to_1.reserve(1 + level_0.size());
   edges_0_to_1.push_back(0);
   for (uint i_0 = 0; i_0 < level_0.size(); ++i_0) {
-    db_query.append(DbStorage::Columns::dag_blocks, RLP(level_0_extra[i_0]).toVector<h256>());
+    for (auto const &dag_blk_hash : RLP(DbStorage::toBytesConstRef(level_0_extra[i_0]))) {
+      db_query.append(DbStorage::Columns::dag_blocks, DbStorage::toSlice(dag_blk_hash.payload()), false);
+    }
     edges_0_to_1.push_back(db_query.size());
   }
-  auto level_1 = db_query.execute();
+  auto level_1 = db_query.execute_pinned();
   vector<uint> edges_1_to_2;
   edges_1_to_2.reserve(1 + level_1.size());
   edges_1_to_2.push_back(0);
   for (auto const &dag_blk_raw : level_1) {
-    db_query.append(DbStorage::Columns::transactions, DagBlock::extract_transactions_from_rlp(RLP(dag_blk_raw)));
+    for (auto const &trx_hash : DagBlock::transactions_rlp(RLP(DbStorage::toBytesConstRef(dag_blk_raw)))) {
+      db_query.append(DbStorage::Columns::transactions, DbStorage::toSlice(trx_hash.payload()), false);
+    }
     edges_1_to_2.push_back(db_query.size());
   }
-  auto level_2 = db_query.execute();
+  auto level_2 = db_query.execute_pinned();
   for (uint i_0 = 0; i_0 < level_0.size(); ++i_0) {
     s.appendList(2);
     s.appendRaw(level_0[i_0].rlp());
@@ -1088,16 +1189,53 @@ void TaraxaCapability::sendPbftBlocks(NodeID const &_id, size_t height_to_sync,
     s.appendList(end_1 - start_1);
     for (uint i_1 = start_1; i_1 < end_1; ++i_1) {
       s.appendList(2);
-      s.appendRaw(level_1[i_1]);
+      s.appendRaw(DbStorage::toBytesConstRef(level_1[i_1]));
       auto start_2 = edges_1_to_2[i_1];
       auto end_2 = edges_1_to_2[i_1 + 1];
       s.appendList(end_2 - start_2);
       for (uint i_2 = start_2; i_2 < end_2; ++i_2) {
-        s.appendRaw(level_2[i_2]);
+        s.appendRaw(DbStorage::toBytesConstRef(level_2[i_2]));
       }
     }
   }
-  host_.capabilityHost()->sealAndSend(_id, s);
+}
+
+void TaraxaCapability::sendPbftBlocks(NodeID const &_id, size_t height_to_sync, size_t blocks_to_transfer) {
+  LOG(log_dg_pbft_sync_) << "In sendPbftBlocks, peer want to sync from pbft chain height " << height_to_sync
+                         << ", will send at most " << blocks_to_transfer << " pbft blocks to " << _id;
+  // Finalized periods never change, so a full response for a range is reused for all peers syncing the same range
+  auto const cache_key = std::make_pair(uint64_t(height_to_sync), blocks_to_transfer);
+  if (auto cached = sync_responses_cache_.get(cache_key)) {
+    RLPStream s;
+    host_.capabilityHost()->prep(_id, name(), s, PbftBlockPacket, blocks_to_transfer);
+    s.appendRaw(**cached, blocks_to_transfer);
+    sealAndSend(_id, PbftBlockPacket, s);
+    LOG(log_dg_pbft_sync_) << "Sending cached PbftCertBlocks from height " << height_to_sync << " to " << _id;
+    return;
+  }
+
+  auto pbft_cert_blks = pbft_chain_->getPbftBlocks(height_to_sync, blocks_to_transfer);
+  RLPStream s;
+  host_.capabilityHost()->prep(_id, name(), s, PbftBlockPacket, pbft_cert_blks.size());
+  if (pbft_cert_blks.empty()) {
+    sealAndSend(_id, PbftBlockPacket, s);
+    LOG(log_dg_pbft_sync_) << "In sendPbftBlocks, sent no pbft blocks to " << _id;
+    return;
+  }
+  // A response shorter than requested ends at the chain head and changes as the chain grows, it is encoded straight
+  // into the packet. So is everything when the cache is disabled.
+  if (pbft_cert_blks.size() == blocks_to_transfer && conf_.network_pbft_sync_cache_size > 0) {
+    RLPStream items;
+    encodePbftBlocks(pbft_cert_blks, items);
+    auto payload = std::make_shared<taraxa::bytes>();
+    items.swapOut(*payload);
+    s.appendRaw(*payload, pbft_cert_blks.size());
+    auto const payload_size = payload->size();
+    sync_responses_cache_.put(cache_key, std::move(payload), payload_size);
+  } else {
+    encodePbftBlocks(pbft_cert_blks, s);
+  }
+  sealAndSend(_id, PbftBlockPacket, s);
   // Question: will send multiple times to a same receiver, why?
   LOG(log_dg_pbft_sync_) << "Sending PbftCertBlocks to " << _id;
 }
@@ -1110,7 +1248,7 @@ void TaraxaCapability::sendPbftBlock(NodeID const &_id, taraxa::PbftBlock const
   host_.capabilityHost()->prep(_id, name(), s, NewPbftBlockPacket, 2);
   pbft_block.streamRLP(s, true);
   s << pbft_chain_size;
-  host_.capabilityHost()->sealAndSend(_id, s);
+  sealAndSend(_id, NewPbftBlockPacket, s);
 }
 
 void TaraxaCapability::syncPbftNextVotes(uint64_t const pbft_round) {
@@ -1142,7 +1280,7 @@ void TaraxaCapability::requestPbftNextVotes(NodeID const &peerID, uint64_t const
   host_.capabilityHost()->prep(peerID, name(), s, GetPbftNextVotes, 1);
   s << pbft_round;
   LOG(log_dg_next_votes_sync_) << "Sending GetPbftNextVotes with round: " << pbft_round;
-  host_.capabilityHost()->sealAndSend(peerID, s);
+  sealAndSend(peerID, GetPbftNextVotes, s);
 }
 
 void TaraxaCapability::sendPbftNextVotes(NodeID const &peerID) {
@@ -1156,7 +1294,7 @@ void TaraxaCapability::sendPbftNextVotes(NodeID const &peerID) {
     s.appendRaw(next_vote.rlp());
     LOG(log_dg_next_votes_sync_) << "Send next vote " << next_vote.getHash();
   }
-  host_.capabilityHost()->sealAndSend(peerID, s);
+  sealAndSend(peerID, PbftNextVotesPacket, s);
 }
 
 Json::Value TaraxaCapability::getStatus() const {
@@ -1175,11 +1313,12 @@ Json::Value TaraxaCapability::getStatus() const {
   Json::Value counters;
   for (uint8_t it = 0; it != PacketCount; it++) {
     Json::Value counter;
-    auto total = packet_count.find(it)->second;
+    auto const &packet_metrics = metrics_.packet(it);
+    auto total = packet_metrics.traffic.packets_in.load();
     counter["total"] = Json::UInt64(total);
     if (total > 0) {
-      counter["avg packet size"] = Json::UInt64(packet_size.find(it)->second / total);
-      auto unique = unique_packet_count.find(it)->second;
+      counter["avg packet size"] = Json::UInt64(packet_metrics.traffic.bytes_in.load() / total);
+      auto unique = packet_metrics.unique_in.load();
       if (unique > 0) {
         counter["unique"] = Json::UInt64(unique);
         counter["unique %"] = Json::UInt64(unique * 100 / total);
@@ -1187,10 +1326,11 @@ Json::Value TaraxaCapability::getStatus() const {
       counters[packetToPacketName(it)] = counter;
     }
   }
-  counters["transaction count"] = Json::UInt64(received_trx_count);
-  counters["unique transaction count"] = Json::UInt64(unique_received_trx_count);
-  if (received_trx_count)
-    counters["unique transaction %"] = Json::UInt64(unique_received_trx_count * 100 / received_trx_count);
+  auto const trx_count = received_trx_count.load();
+  auto const unique_trx_count = unique_received_trx_count.load();
+  counters["transaction count"] = Json::UInt64(trx_count);
+  counters["unique transaction count"] = Json::UInt64(unique_trx_count);
+  if (trx_count) counters["unique transaction %"] = Json::UInt64(unique_trx_count * 100 / trx_count);
   res["counters"] = counters;
   return res;
 }
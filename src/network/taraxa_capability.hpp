@@ -6,14 +6,19 @@
 #include <libp2p/Host.h>
 #include <libp2p/Session.h>
 
+#include <boost/functional/hash.hpp>
 #include <chrono>
+#include <mutex>
 #include <set>
 #include <thread>
 
 #include "config/config.hpp"
 #include "consensus/vote.hpp"
 #include "dag/dag_block_manager.hpp"
+#include "network/network_metrics.hpp"
 #include "transaction_manager/transaction.hpp"
+#include "util/rotating_bloom_filter.hpp"
+#include "util/simple_event.hpp"
 #include "util/util.hpp"
 
 namespace taraxa {
@@ -48,23 +53,26 @@ struct InvalidDataException : public std::runtime_error {
 
 class TaraxaPeer : public boost::noncopyable {
  public:
-  TaraxaPeer()
-      : known_blocks_(10000, 1000),
-        known_pbft_blocks_(10000, 1000),
-        known_votes_(10000, 1000),
-        known_transactions_(100000, 10000) {}
-  explicit TaraxaPeer(NodeID id)
-      : m_id(id),
-        known_blocks_(10000, 1000),
-        known_pbft_blocks_(10000, 1000),
-        known_votes_(10000, 1000),
-        known_transactions_(100000, 10000) {}
+  // Known items are forgotten after 1-2 generations, a generation lasts up to known_items_max_age (unbounded if zero)
+  explicit TaraxaPeer(double known_items_false_positive_rate = 0.001,
+                      std::chrono::milliseconds known_items_max_age = std::chrono::milliseconds::zero())
+      : known_blocks_(10000, known_items_false_positive_rate, known_items_max_age),
+        known_transactions_(100000, known_items_false_positive_rate, known_items_max_age),
+        known_votes_(10000, known_items_false_positive_rate, known_items_max_age),
+        known_pbft_blocks_(10000, known_items_false_positive_rate, known_items_max_age) {}
+  explicit TaraxaPeer(NodeID id, double known_items_false_positive_rate = 0.001,
+                      std::chrono::milliseconds known_items_max_age = std::chrono::milliseconds::zero())
+      : TaraxaPeer(known_items_false_positive_rate, known_items_max_age) {
+    m_id = id;
+  }
 
   bool isBlockKnown(blk_hash_t const &_hash) const { return known_blocks_.count(_hash); }
   void markBlockAsKnown(blk_hash_t const &_hash) { known_blocks_.insert(_hash); }
 
   bool isTransactionKnown(trx_hash_t const &_hash) const { return known_transactions_.count(_hash); }
   void markTransactionAsKnown(trx_hash_t const &_hash) { known_transactions_.insert(_hash); }
+  // Returns false if the transaction was already known, atomic with respect to concurrent calls
+  bool markTransactionAsKnownIfNew(trx_hash_t const &_hash) { return known_transactions_.insertIfNew(_hash); }
 
   void clearAllKnownBlocksAndTransactions() {
     known_transactions_.clear();
@@ -85,21 +93,49 @@ class TaraxaPeer : public boost::noncopyable {
 
   void statusReceived() { status_check_count_ = 0; }
 
+  // Queues transaction to be sent to the peer, returns total size in bytes of all queued transactions
+  size_t queueTransaction(std::shared_ptr<taraxa::bytes const> transaction) {
+    std::unique_lock lock(queued_transactions_mutex_);
+    if (queued_transactions_.empty()) {
+      queued_transactions_since_ = std::chrono::steady_clock::now();
+    }
+    queued_transactions_size_ += transaction->size();
+    queued_transactions_.emplace_back(std::move(transaction));
+    return queued_transactions_size_;
+  }
+
+  // queued_since is set to the time the oldest of the returned transactions was queued
+  std::vector<std::shared_ptr<taraxa::bytes const>> takeQueuedTransactions(
+      std::chrono::steady_clock::time_point &queued_since) {
+    std::unique_lock lock(queued_transactions_mutex_);
+    queued_since = queued_transactions_since_;
+    queued_transactions_size_ = 0;
+    return std::move(queued_transactions_);
+  }
+
   bool syncing_ = false;
   uint64_t dag_level_ = 0;
   uint64_t pbft_chain_size_ = 0;
   uint64_t pbft_round_ = 1;
 
  private:
-  ExpirationCache<blk_hash_t> known_blocks_;
-  ExpirationCache<trx_hash_t> known_transactions_;
+  // Bloom filters might report an unknown item as known (with configured false positive rate), it is acceptable
+  // as gossiping relies on multiple peers and missing items are requested explicitly
+  util::RotatingBloomFilter<blk_hash_t> known_blocks_;
+  util::RotatingBloomFilter<trx_hash_t> known_transactions_;
   // PBFT
-  ExpirationCache<vote_hash_t> known_votes_;  // for peers
-  ExpirationCache<blk_hash_t> known_pbft_blocks_;
+  util::RotatingBloomFilter<vote_hash_t> known_votes_;  // for peers
+  util::RotatingBloomFilter<blk_hash_t> known_pbft_blocks_;
 
   NodeID m_id;
 
   uint16_t status_check_count_ = 0;
+
+  // Transactions waiting to be sent in a single TransactionPacket
+  std::vector<std::shared_ptr<taraxa::bytes const>> queued_transactions_;
+  size_t queued_transactions_size_ = 0;
+  std::chrono::steady_clock::time_point queued_transactions_since_;
+  std::mutex queued_transactions_mutex_;
 };
 
 class TaraxaCapability : public CapabilityFace, public Worker {
@@ -124,7 +160,15 @@ class TaraxaCapability : public CapabilityFace, public Worker {
         dag_mgr_(dag_mgr),
         dag_blk_mgr_(dag_blk_mgr),
         trx_mgr_(trx_mgr),
-        lambda_ms_min_(lambda_ms_min) {
+        lambda_ms_min_(lambda_ms_min),
+        sync_responses_cache_(_conf.network_pbft_sync_cache_size),
+        metrics_([this] {
+          std::vector<std::string> packet_names;
+          for (uint8_t it = 0; it != PacketCount; it++) {
+            packet_names.push_back(packetToPacketName(it));
+          }
+          return packet_names;
+        }()) {
     LOG_OBJECTS_CREATE("TARCAP");
     LOG_OBJECTS_CREATE_SUB("PBFTSYNC", pbft_sync);
     LOG_OBJECTS_CREATE_SUB("DAGSYNC", dag_sync);
@@ -134,11 +178,6 @@ class TaraxaCapability : public CapabilityFace, public Worker {
     LOG_OBJECTS_CREATE_SUB("PBFTPRP", pbft_prp);
     LOG_OBJECTS_CREATE_SUB("VOTEPRP", vote_prp);
     LOG_OBJECTS_CREATE_SUB("NETPER", net_per);
-    for (uint8_t it = 0; it != PacketCount; it++) {
-      packet_count[it] = 0;
-      packet_size[it] = 0;
-      unique_packet_count[it] = 0;
-    }
   }
   virtual ~TaraxaCapability() = default;
   std::string name() const override { return "taraxa"; }
@@ -171,6 +210,7 @@ class TaraxaCapability : public CapabilityFace, public Worker {
   vector<NodeID> selectPeers(std::function<bool(TaraxaPeer const &)> const &_predicate);
   vector<NodeID> getAllPeers() const;
   Json::Value getStatus() const;
+  NetworkMetrics const &getMetrics() const { return metrics_; }
   std::pair<std::vector<NodeID>, std::vector<NodeID>> randomPartitionPeers(std::vector<NodeID> const &_peers,
                                                                            std::size_t _number);
   std::pair<int, int> retrieveTestData(NodeID const &_id);
@@ -183,6 +223,10 @@ class TaraxaCapability : public CapabilityFace, public Worker {
   void requestBlock(NodeID const &_id, blk_hash_t hash);
   void requestPendingDagBlocks(NodeID const &_id);
   void sendTransactions(NodeID const &_id, std::vector<taraxa::bytes> const &transactions);
+  void sendQueuedTransactions(NodeID const &_id, std::shared_ptr<TaraxaPeer> const &peer);
+  // Queues the verified transactions the peer doesn't know yet, new ones are queued as they get verified. Used when
+  // the peer connects or stops syncing, it was skipped by the gossip meanwhile
+  void queueVerifiedTransactions(NodeID const &_id, std::shared_ptr<TaraxaPeer> const &peer);
   bool processSyncDagBlocks(NodeID const &_id);
 
   std::map<blk_hash_t, taraxa::DagBlock> getBlocks();
@@ -190,6 +234,7 @@ class TaraxaCapability : public CapabilityFace, public Worker {
 
   void doBackgroundWork();
   void sendTransactions();
+  void dumpMetrics();
   std::string packetToPacketName(byte const &packet) const;
 
   // PBFT
@@ -199,6 +244,8 @@ class TaraxaCapability : public CapabilityFace, public Worker {
   void sendPbftBlock(NodeID const &_id, taraxa::PbftBlock const &pbft_block, uint64_t const &pbft_chain_size);
   void requestPbftBlocks(NodeID const &_id, size_t height_to_sync);
   void sendPbftBlocks(NodeID const &_id, size_t height_to_sync, size_t blocks_to_transfer);
+  // Appends PbftBlockPacket items of the blocks to the stream
+  void encodePbftBlocks(std::vector<PbftBlockCert> const &pbft_cert_blks, RLPStream &s);
   void syncPbftNextVotes(uint64_t const pbft_round);
   void requestPbftNextVotes(NodeID const &peerID, uint64_t const pbft_round);
   void sendPbftNextVotes(NodeID const &peerID);
@@ -209,11 +256,20 @@ class TaraxaCapability : public CapabilityFace, public Worker {
   void erasePeer(NodeID const &node_id);
   void insertPeer(NodeID const &node_id, std::shared_ptr<TaraxaPeer> const &peer);
 
+  // Publishes event_syncing_changed if the syncing state changes
+  void setSyncing(bool syncing);
+
+  // Published with the new value of syncing_ whenever it changes
+  util::SimpleEvent<bool> const event_syncing_changed{};
   bool syncing_ = false;
   bool requesting_pending_dag_blocks_ = false;
   NodeID requesting_pending_dag_blocks_node_id_;
 
  private:
+  bool handlePacket(NodeID const &_nodeID, unsigned _id, RLP const &_r);
+  // Sends the packet prepared in _s, accounting it in the network metrics
+  void sealAndSend(NodeID const &_id, unsigned _packet_type, RLPStream &_s);
+
   Host &host_;
   std::unordered_map<NodeID, int> cnt_received_messages_;
   std::unordered_map<NodeID, int> test_sums_;
@@ -236,6 +292,9 @@ class TaraxaCapability : public CapabilityFace, public Worker {
   std::shared_ptr<DagBlockManager> dag_blk_mgr_;
   std::shared_ptr<TransactionManager> trx_mgr_;
   uint32_t lambda_ms_min_;
+  // [pbft sync period, number of pbft blocks] -> encoded PbftBlockPacket items, only full responses are cached
+  LruCache<std::pair<uint64_t, size_t>, std::shared_ptr<taraxa::bytes const>, boost::hash<std::pair<uint64_t, size_t>>>
+      sync_responses_cache_;
 
   std::unordered_map<NodeID, std::shared_ptr<TaraxaPeer>> peers_;
   mutable boost::shared_mutex peers_mutex_;
@@ -255,11 +314,10 @@ class TaraxaCapability : public CapabilityFace, public Worker {
   std::uniform_int_distribution<std::mt19937::result_type> random_dist_;
   uint16_t check_status_interval_ = 0;
 
-  std::map<uint8_t, uint64_t> packet_count;
-  std::map<uint8_t, uint64_t> packet_size;
-  std::map<uint8_t, uint64_t> unique_packet_count;
-  uint64_t received_trx_count = 0;
-  uint64_t unique_received_trx_count = 0;
+  NetworkMetrics metrics_;
+  std::atomic<std::chrono::steady_clock::time_point> perf_log_begin_ = std::chrono::steady_clock::now();
+  std::atomic<uint64_t> received_trx_count = 0;
+  std::atomic<uint64_t> unique_received_trx_count = 0;
 
   LOG_OBJECTS_DEFINE;
   LOG_OBJECTS_DEFINE_SUB(pbft_sync);
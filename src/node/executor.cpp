@@ -1,6 +1,7 @@
 #include "executor.hpp"
 
 #include "config/config.hpp"
+#include "util/flat_hash.hpp"
 
 namespace taraxa {
 
@@ -23,6 +24,7 @@ Executor::Executor(addr_t node_addr, std::shared_ptr<DbStorage> db, std::shared_
   num_executed_blk_ = db_->getStatusField(taraxa::StatusDbField::ExecutedBlkCount);
   num_executed_trx_ = db_->getStatusField(taraxa::StatusDbField::ExecutedTrxCount);
   transactions_tmp_buf_.reserve(expected_max_trx_per_block);
+  committed_period_ = pbft_chain_->getPbftExecutedChainSize();
 }
 
 Executor::~Executor() { stop(); }
@@ -34,6 +36,7 @@ void Executor::start() {
     return;
   }
   LOG(log_nf_) << "Executor start...";
+  prune_worker_ = std::make_unique<std::thread>([this]() { pruneSnapshots_(); });
   exec_worker_ = std::make_unique<std::thread>([this]() { run(); });
 }
 
@@ -43,9 +46,39 @@ void Executor::stop() {
   }
   cv_executor.notify_all();
   exec_worker_->join();
+  {
+    std::unique_lock lock(prune_mu_);
+    prune_cv_.notify_all();
+  }
+  prune_worker_->join();
+  {
+    std::unique_lock lock(committed_period_mu_);
+    committed_period_cv_.notify_all();
+  }
   LOG(log_nf_) << "Executor stopped";
 }
 
+void Executor::pruneSnapshots_() {
+  std::unique_lock lock(prune_mu_);
+  while (true) {
+    prune_cv_.wait(lock, [this] { return stopped_ || prune_requested_; });
+    // A requested pruning is done even if stopped
+    if (!prune_requested_) {
+      return;
+    }
+    prune_requested_ = false;
+    lock.unlock();
+    db_->pruneSnapshots();
+    lock.lock();
+  }
+}
+
+bool Executor::waitForPeriodCommitted(uint64_t period) {
+  std::unique_lock lock(committed_period_mu_);
+  committed_period_cv_.wait(lock, [&] { return stopped_ || committed_period_ >= period; });
+  return committed_period_ >= period;
+}
+
 void Executor::run() {
   LOG(log_nf_) << "Executor run...";
   uLock lock(shared_mutex_executor_);
@@ -86,11 +119,10 @@ void Executor::executePbftBlocks_() {
       transactions_tmp_buf_.clear();
       DbStorage::MultiGetQuery db_query(db_, transactions_tmp_buf_.capacity() + 100);
       auto dag_blks_raw = db_query.append(DbStorage::Columns::dag_blocks, finalized_dag_blk_hashes, false).execute();
-      unordered_set<h256> unique_trxs;
-      unique_trxs.reserve(transactions_tmp_buf_.capacity());
+      util::FlatHashSet<h256> unique_trxs(transactions_tmp_buf_.capacity());
       for (auto const &dag_blk_raw : dag_blks_raw) {
         for (auto const &trx_h : DagBlock::extract_transactions_from_rlp(RLP(dag_blk_raw))) {
-          if (!unique_trxs.insert(trx_h).second) {
+          if (!unique_trxs.insert(trx_h)) {
             continue;
           }
           db_query.append(DbStorage::Columns::executed_transactions, trx_h);
@@ -147,7 +179,7 @@ void Executor::executePbftBlocks_() {
     // Update executed PBFT blocks size
     pbft_chain_->updateExecutedPbftChainSize();
     // Update PBFT chain head block
-    db_->addPbftHeadToBatch(pbft_chain_->getHeadHash(), pbft_chain_->getJsonStr(), batch);
+    db_->addPbftHeadToBatch(pbft_chain_->getHeadHash(), pbft_chain_->getRlp(), batch);
 
     // Set DAG blocks period
     dag_mgr_->setDagBlockOrder(anchor_hash, pbft_period, finalized_dag_blk_hashes, batch);
@@ -164,15 +196,24 @@ void Executor::executePbftBlocks_() {
 
     // After DB commit, confirm in final chain(Ethereum)
     final_chain_->advance_confirm();
+    {
+      std::unique_lock lock(committed_period_mu_);
+      committed_period_ = pbft_period;
+      committed_period_cv_.notify_all();
+    }
 
-    // Creates snapshot if needed
+    // Creates snapshot if needed, before the next state transition. Old snapshots are deleted by prune_worker_
     if (db_->createSnapshot(pbft_period)) {
       final_chain_->create_snapshot(pbft_period);
+      std::unique_lock lock(prune_mu_);
+      prune_requested_ = true;
+      prune_cv_.notify_all();
     }
 
     // Ethereum filter
-    trx_mgr_->getFilterAPI()->note_block(new_eth_header.hash());
-    trx_mgr_->getFilterAPI()->note_receipts(trx_receipts);
+    trx_mgr_->getFilterAPI()->note_block(new_eth_header.hash(), new_eth_header.number());
+    trx_mgr_->getFilterAPI()->note_receipts(
+        util::make_range_view(transactions_tmp_buf_).map([](auto const &trx) { return trx.sha3(); }), *trx_receipts);
 
     // Update web server
     if (ws_server_) {
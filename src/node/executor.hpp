@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 #include "chain/final_chain.hpp"
 #include "consensus/pbft_chain.hpp"
@@ -24,6 +26,8 @@ class Executor {
   void start();
   void stop();
   void run();
+  // Blocks until the period is committed or the executor is stopped, returns whether the period is committed
+  bool waitForPeriodCommitted(uint64_t period);
 
   boost::condition_variable_any cv_executor;
 
@@ -31,6 +35,8 @@ class Executor {
   using uLock = boost::unique_lock<boost::shared_mutex>;
 
   void executePbftBlocks_();
+  // Snapshot pruning worker loop
+  void pruneSnapshots_();
 
   unique_ptr<ReplayProtectionService> replay_protection_service_;
   std::shared_ptr<DbStorage> db_ = nullptr;
@@ -44,6 +50,18 @@ class Executor {
   std::atomic<bool> stopped_ = true;
   std::unique_ptr<std::thread> exec_worker_ = nullptr;
 
+  // DB and state snapshots are still taken on the executor thread, between the commit of their period and the state
+  // transition of the next one, so they are consistent. Only the deletion of old snapshots is moved to
+  // prune_worker_.
+  std::unique_ptr<std::thread> prune_worker_ = nullptr;
+  std::mutex prune_mu_;
+  std::condition_variable prune_cv_;
+  bool prune_requested_ = false;
+
+  std::mutex committed_period_mu_;
+  std::condition_variable committed_period_cv_;
+  uint64_t committed_period_ = 0;
+
   dev::eth::Transactions transactions_tmp_buf_;
   std::atomic<uint64_t> num_executed_blk_ = 0;
   std::atomic<uint64_t> num_executed_trx_ = 0;
@@ -9,6 +9,7 @@
 #include <chrono>
 #include <stdexcept>
 
+#include "aleth/eth.hpp"
 #include "aleth/node_api.hpp"
 #include "aleth/state_api.hpp"
 #include "consensus/block_proposer.hpp"
@@ -55,20 +56,20 @@ void FullNode::init() {
   {
     if (conf_.test_params.rebuild_db) {
       emplace(old_db_, conf_.db_path, conf_.test_params.db_snapshot_each_n_pbft_block,
-              conf_.test_params.db_max_snapshots, conf_.test_params.db_revert_to_period, node_addr, true);
+              conf_.test_params.db_max_snapshots, conf_.test_params.db_revert_to_period, node_addr, true, conf_.db);
     }
 
     emplace(db_, conf_.db_path, conf_.test_params.db_snapshot_each_n_pbft_block, conf_.test_params.db_max_snapshots,
-            conf_.test_params.db_revert_to_period, node_addr);
+            conf_.test_params.db_revert_to_period, node_addr, false, conf_.db);
 
     if (db_->hasMinorVersionChanged()) {
       LOG(log_si_) << "Minor DB version has changed. Rebuilding Db";
       conf_.test_params.rebuild_db = true;
       db_ = nullptr;
       emplace(old_db_, conf_.db_path, conf_.test_params.db_snapshot_each_n_pbft_block,
-              conf_.test_params.db_max_snapshots, conf_.test_params.db_revert_to_period, node_addr, true);
+              conf_.test_params.db_max_snapshots, conf_.test_params.db_revert_to_period, node_addr, true, conf_.db);
       emplace(db_, conf_.db_path, conf_.test_params.db_snapshot_each_n_pbft_block, conf_.test_params.db_max_snapshots,
-              conf_.test_params.db_revert_to_period, node_addr);
+              conf_.test_params.db_revert_to_period, node_addr, false, conf_.db);
     }
 
     if (db_->getNumDagBlocks() == 0) {
@@ -85,7 +86,7 @@ void FullNode::init() {
     trx_mgr_->setPendingBlock(
         aleth::NewPendingBlock(final_chain_head->number(), getAddress(), final_chain_head->hash(), db_));
     for (auto const &h : trx_mgr_->getPendingBlock()->transactionHashes()) {
-      auto status = db_->getTransactionStatus(h);
+      auto status = trx_mgr_->getTransactionStatus(h);
       if (status == TransactionStatus::in_queue_unverified || status == TransactionStatus::in_queue_verified) {
         auto trx = db_->getTransaction(h);
         if (!trx_mgr_->insertTrx(*trx, true).first) {
@@ -117,29 +118,34 @@ void FullNode::init() {
     jsonrpc_io_ctx_ = make_unique<boost::asio::io_context>();
 
     emplace(jsonrpc_api_, new net::Test(getShared()), new net::Taraxa(getShared()), new net::Net(getShared()),
-            new dev::rpc::Eth(aleth::NewNodeAPI(conf_.chain.chain_id, kp_.secret(),
-                                                [this](auto const &trx) {
-                                                  auto [ok, err_msg] = trx_mgr_->insertTransaction(trx, true);
-                                                  if (!ok) {
-                                                    BOOST_THROW_EXCEPTION(
-                                                        runtime_error(fmt("Transaction is rejected.\n"
-                                                                          "RLP: %s\n"
-                                                                          "Reason: %s",
-                                                                          dev::toJS(*trx.rlp()), err_msg)));
-                                                  }
-                                                }),
-                              trx_mgr_->getFilterAPI(), aleth::NewStateAPI(final_chain_), trx_mgr_->getPendingBlock(),
-                              final_chain_, [] { return 0; }));
+            new aleth::Eth({conf_.rpc->logs_max_block_range, conf_.rpc->logs_max_results},
+                           aleth::NewNodeAPI(conf_.chain.chain_id, kp_.secret(),
+                                             [this](auto const &trx) {
+                                               auto [ok, err_msg] = trx_mgr_->insertTransaction(trx, true);
+                                               if (!ok) {
+                                                 BOOST_THROW_EXCEPTION(
+                                                     runtime_error(fmt("Transaction is rejected.\n"
+                                                                       "RLP: %s\n"
+                                                                       "Reason: %s",
+                                                                       dev::toJS(*trx.rlp()), err_msg)));
+                                               }
+                                             }),
+                           trx_mgr_->getFilterAPI(), aleth::NewStateAPI(final_chain_), trx_mgr_->getPendingBlock(),
+                           final_chain_, [] { return 0; }));
 
     if (conf_.rpc->http_port) {
       jsonrpc_http_ = make_shared<net::RpcServer>(
-          *jsonrpc_io_ctx_, boost::asio::ip::tcp::endpoint{conf_.rpc->address, *conf_.rpc->http_port}, node_addr);
+          *jsonrpc_io_ctx_, boost::asio::ip::tcp::endpoint{conf_.rpc->address, *conf_.rpc->http_port}, node_addr,
+          std::chrono::milliseconds(conf_.rpc->http_idle_timeout_ms), conf_.rpc->http_max_connections,
+          conf_.rpc->batch_threads_num);
       jsonrpc_api_->addConnector(jsonrpc_http_);
     }
 
     if (conf_.rpc->ws_port) {
       jsonrpc_ws_ = make_shared<net::WSServer>(
-          *jsonrpc_io_ctx_, boost::asio::ip::tcp::endpoint{conf_.rpc->address, *conf_.rpc->ws_port}, node_addr);
+          *jsonrpc_io_ctx_, boost::asio::ip::tcp::endpoint{conf_.rpc->address, *conf_.rpc->ws_port}, node_addr,
+          net::WSQueueLimits{conf_.rpc->ws_max_queue_size, conf_.rpc->ws_max_queued_bytes,
+                             net::wsOverflowPolicyFromString(conf_.rpc->ws_overflow_policy)});
       jsonrpc_api_->addConnector(jsonrpc_ws_);
     }
   }
@@ -249,6 +255,9 @@ void FullNode::close() {
       executor_->setWSServer(nullptr);
     }
 
+    if (jsonrpc_http_) {
+      jsonrpc_http_->StopListening();
+    }
     jsonrpc_io_ctx_->stop();
 
     for (size_t i = 0; i < jsonrpc_threads_.size(); ++i) {
@@ -330,9 +339,9 @@ void FullNode::rebuildDb() {
       }
     }
 
-    // Wait if more than 10 pbft blocks in queue to be processed
-    while (pbft_chain_->pbftSyncedQueueSize() > 10) {
-      thisThreadSleepForMilliSeconds(10);
+    // Wait if more than 10 pbft blocks in queue to be processed, the queue is not drained anymore once closed
+    if (!pbft_chain_->waitPbftSyncedQueueSize(10, stopped_)) {
+      return;
     }
     period++;
 
@@ -340,11 +349,9 @@ void FullNode::rebuildDb() {
       break;
     }
   }
-  while (pbft_chain_->pbftSyncedQueueSize() > 0 || pbft_chain_->getPbftExecutedChainSize() != period - 1) {
-    thisThreadSleepForMilliSeconds(1000);
-    LOG(log_nf_) << "Waiting on PBFT blocks to be processed. Queue size: " << pbft_chain_->pbftSyncedQueueSize()
-                 << " Chain size: " << pbft_chain_->getPbftExecutedChainSize();
-  }
+  LOG(log_nf_) << "Waiting on PBFT blocks to be processed. Queue size: " << pbft_chain_->pbftSyncedQueueSize()
+               << " Chain size: " << pbft_chain_->getPbftExecutedChainSize();
+  executor_->waitForPeriodCommitted(period - 1);
 }
 
 dev::Signature FullNode::signMessage(std::string const &message) { return dev::sign(kp_.secret(), dev::sha3(message)); }
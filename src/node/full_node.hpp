@@ -122,6 +122,9 @@ class FullNode : public std::enable_shared_from_this<FullNode> {
   auto const &getExecutor() const { return executor_; }
   auto const &getFinalChain() const { return final_chain_; }
   auto const &getTrxOrderMgr() const { return trx_order_mgr_; }
+  auto const &getBlockProposer() const { return blk_proposer_; }
+  auto const &getJsonRpcHttp() const { return jsonrpc_http_; }
+  auto const &getJsonRpcWs() const { return jsonrpc_ws_; }
 
   auto const &getAddress() const { return kp_.address(); }
   auto const &getPublicKey() const { return kp_.pub(); }
@@ -159,7 +162,7 @@ class FullNode : public std::enable_shared_from_this<FullNode> {
   static constexpr uint16_t c_database_major_version = 0;
   // Minor version should be modified when changes to the database are made in the tables that can be rebuilt from the
   // basic tables
-  static constexpr uint16_t c_database_minor_version = 1;
+  static constexpr uint16_t c_database_minor_version = 2;
 };
 
 }  // namespace taraxa
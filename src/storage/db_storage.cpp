@@ -5,6 +5,9 @@
 
 #include "consensus/vote.hpp"
 #include "node/full_node.hpp"
+#include "rocksdb/cache.h"
+#include "rocksdb/filter_policy.h"
+#include "rocksdb/table.h"
 #include "rocksdb/utilities/checkpoint.h"
 #include "transaction_manager/transaction.hpp"
 
@@ -15,7 +18,7 @@ using namespace rocksdb;
 namespace fs = std::filesystem;
 
 DbStorage::DbStorage(fs::path const& path, uint32_t db_snapshot_each_n_pbft_block, uint32_t db_max_snapshots,
-                     uint32_t db_revert_to_period, addr_t node_addr, bool rebuild)
+                     uint32_t db_revert_to_period, addr_t node_addr, bool rebuild, DbConfig const& config)
     : path_(path),
       // First - lazy init default column for rocksdb - must be called before accessing rocksdb because of static init
       // order fail !!! For handles_ initialization is used comma-operator that evaluates first expression, but uses
@@ -45,9 +48,12 @@ DbStorage::DbStorage(fs::path const& path, uint32_t db_snapshot_each_n_pbft_bloc
   rocksdb::Options options;
   options.create_missing_column_families = true;
   options.create_if_missing = true;
+  if (config.max_background_jobs) {
+    options.max_background_jobs = config.max_background_jobs;
+  }
   vector<ColumnFamilyDescriptor> descriptors;
   std::transform(Columns::all.begin(), Columns::all.end(), std::back_inserter(descriptors),
-                 [](const Column& col) { return ColumnFamilyDescriptor(col.name, ColumnFamilyOptions()); });
+                 [&](const Column& col) { return ColumnFamilyDescriptor(col.name, columnOptions(col, config)); });
   LOG_OBJECTS_CREATE("DBS");
 
   // Iterate over the db folders and populate snapshot set
@@ -78,6 +84,37 @@ DbStorage::DbStorage(fs::path const& path, uint32_t db_snapshot_each_n_pbft_bloc
   }
 }
 
+ColumnFamilyOptions DbStorage::columnOptions(Column const& col, DbConfig const& config) {
+  ColumnFamilyOptions ret;
+  BlockBasedTableOptions table_options;
+  if (config.block_cache_size) {
+    if (!block_cache_) {
+      block_cache_ = NewLRUCache(config.block_cache_size);
+    }
+    table_options.block_cache = block_cache_;
+    // Keep index and filter blocks within the memory budget, pinning L0 ones as they are read by every lookup
+    table_options.cache_index_and_filter_blocks = true;
+    table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+  }
+  if (auto profile_name = config.columns.find(col.name); profile_name != config.columns.end()) {
+    auto const& profile = config.profiles.at(profile_name->second);
+    if (profile.bloom_bits_per_key) {
+      table_options.filter_policy.reset(NewBloomFilterPolicy(profile.bloom_bits_per_key, false));
+    }
+    if (profile.data_block_hash_index) {
+      table_options.data_block_index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+    }
+    if (profile.write_buffer_size) {
+      ret.write_buffer_size = profile.write_buffer_size;
+    }
+    if (profile.max_write_buffer_number) {
+      ret.max_write_buffer_number = profile.max_write_buffer_number;
+    }
+  }
+  ret.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  return ret;
+}
+
 void DbStorage::loadSnapshots() {
   // Find all the existing folders containing db and state_db snapshots
   for (fs::directory_iterator itr(path_); itr != fs::directory_iterator(); ++itr) {
@@ -107,7 +144,7 @@ void DbStorage::loadSnapshots() {
 
 bool DbStorage::createSnapshot(uint64_t const& period) {
   // Only creates snapshot each db_snapshot_each_n_pbft_block_ periods
-  if (db_snapshot_each_n_pbft_block_ > 0 && period % db_snapshot_each_n_pbft_block_ == 0) {
+  if (isSnapshotPeriod(period)) {
     LOG(log_nf_) << "Creating DB snapshot on period: " << period;
 
     // Create rocskd checkpoint/snapshot
@@ -122,21 +159,29 @@ bool DbStorage::createSnapshot(uint64_t const& period) {
       status = checkpoint->CreateCheckpoint(snapshot_path.string());
     }
     checkStatus(status);
+    lock_guard<mutex> lock(snapshots_mutex_);
     snapshots_.insert(period);
-
-    // Delete any snapshot over db_max_snapshots_
-    if (db_max_snapshots_ && snapshots_.size() > db_max_snapshots_) {
-      while (snapshots_.size() > db_max_snapshots_) {
-        auto snapshot = snapshots_.begin();
-        deleteSnapshot(*snapshot);
-        snapshots_.erase(snapshot);
-      }
-    }
     return true;
   }
   return false;
 }
 
+void DbStorage::pruneSnapshots() {
+  // Delete any snapshot over db_max_snapshots_, the files are removed without holding the lock
+  std::vector<uint64_t> to_delete;
+  {
+    lock_guard<mutex> lock(snapshots_mutex_);
+    while (db_max_snapshots_ && snapshots_.size() > db_max_snapshots_) {
+      auto snapshot = snapshots_.begin();
+      to_delete.push_back(*snapshot);
+      snapshots_.erase(snapshot);
+    }
+  }
+  for (auto const period : to_delete) {
+    deleteSnapshot(period);
+  }
+}
+
 void DbStorage::recoverToPeriod(uint64_t const& period) {
   LOG(log_nf_) << "Revet to snapshot from period: " << period;
 
@@ -396,15 +441,17 @@ void DbStorage::addPbftBlockToBatch(const taraxa::PbftBlock& pbft_block,
   batch_put(*write_batch, Columns::pbft_blocks, pbft_block.getBlockHash(), pbft_block.rlp(true));
 }
 
-string DbStorage::getPbftHead(blk_hash_t const& hash) { return lookup(toSlice(hash.asBytes()), Columns::pbft_head); }
+bytes DbStorage::getPbftHead(blk_hash_t const& hash) {
+  return asBytes(lookup(toSlice(hash.asBytes()), Columns::pbft_head));
+}
 
-void DbStorage::savePbftHead(blk_hash_t const& hash, string const& pbft_chain_head_str) {
-  insert(Columns::pbft_head, toSlice(hash.asBytes()), pbft_chain_head_str);
+void DbStorage::savePbftHead(blk_hash_t const& hash, bytes const& pbft_chain_head) {
+  insert(Columns::pbft_head, toSlice(hash.asBytes()), toSlice(pbft_chain_head));
 }
 
-void DbStorage::addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, std::string const& head_str,
+void DbStorage::addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, bytes const& head,
                                    const taraxa::DbStorage::BatchPtr& write_batch) {
-  batch_put(write_batch, Columns::pbft_head, toSlice(head_hash.asBytes()), head_str);
+  batch_put(write_batch, Columns::pbft_head, toSlice(head_hash.asBytes()), toSlice(head));
 }
 
 bytes DbStorage::getVotes(blk_hash_t const& hash) { return asBytes(lookup(hash, Columns::votes)); }
@@ -469,6 +516,15 @@ void DbStorage::forEach(Column const& col, OnEntry const& f) {
   }
 }
 
+void DbStorage::forEach(Column const& col, Slice const& from, OnEntry const& f) {
+  auto i = u_ptr(db_->NewIterator(read_options_, handle(col)));
+  for (i->Seek(from); i->Valid(); i->Next()) {
+    if (!f(i->key(), i->value())) {
+      break;
+    }
+  }
+}
+
 DbStorage::MultiGetQuery::MultiGetQuery(shared_ptr<DbStorage> const& db, uint capacity) : db_(db) {
   if (capacity) {
     cfs_.reserve(capacity);
@@ -505,6 +561,26 @@ vector<string> DbStorage::MultiGetQuery::execute(bool and_reset) {
   return ret;
 }
 
+vector<PinnableSlice> DbStorage::MultiGetQuery::execute_pinned(bool and_reset) {
+  auto _size = size();
+  if (_size == 0) {
+    return {};
+  }
+  vector<PinnableSlice> ret(_size);
+  for (uint i = 0; i < _size; ++i) {
+    auto status = db_->db_->Get(db_->read_options_, cfs_[i], keys_[i], &ret[i]);
+    if (status.IsNotFound()) {
+      ret[i].Reset();
+    } else {
+      checkStatus(status);
+    }
+  }
+  if (and_reset) {
+    reset();
+  }
+  return ret;
+}
+
 DbStorage::MultiGetQuery& DbStorage::MultiGetQuery::reset() {
   cfs_.clear();
   keys_.clear();
@@ -7,6 +7,7 @@
 
 #include <filesystem>
 #include <functional>
+#include <map>
 #include <string_view>
 
 #include "consensus/pbft_chain.hpp"
@@ -41,6 +42,38 @@ class DbException : public exception {
   string desc_;
 };
 
+// Tuning of a column family, zero values keep rocksdb defaults
+struct DbColumnOptions {
+  // Bits per key of the whole key bloom filter, 10 gives ~1% false positives. Point lookups of missing keys (which are
+  // common, e.g. transactionInDb) then mostly don't touch data blocks at all
+  uint32_t bloom_bits_per_key = 0;
+  // Hash index inside data blocks, point lookups don't binary search within a block
+  bool data_block_hash_index = false;
+  // Memtable size and count, bigger memtables mean less frequent flushes and compactions for append heavy columns
+  uint64_t write_buffer_size = 0;
+  uint32_t max_write_buffer_number = 0;
+};
+
+struct DbConfig {
+  // LRU block cache shared by all the columns (index and filter blocks included), 0 = rocksdb default cache per column
+  uint64_t block_cache_size = 512 * 1024 * 1024;
+  // Number of flush and compaction threads, 0 = rocksdb default
+  uint32_t max_background_jobs = 4;
+  // Named column option profiles
+  std::map<std::string, DbColumnOptions> profiles = {
+      {"point_lookup", {10, true, 0, 0}},
+      {"append_point_lookup", {10, true, 64 * 1024 * 1024, 4}},
+  };
+  // Column name -> profile name, columns which are not listed get rocksdb defaults
+  std::map<std::string, std::string> columns = {
+      {"dag_blocks", "append_point_lookup"},     {"transactions", "append_point_lookup"},
+      {"trx_status", "append_point_lookup"},     {"executed_transactions", "append_point_lookup"},
+      {"dag_blocks_state", "point_lookup"},      {"dag_block_period", "point_lookup"},
+      {"pbft_blocks", "point_lookup"},           {"votes", "point_lookup"},
+      {"pending_transactions", "point_lookup"},
+  };
+};
+
 struct DbStorage {
   using BatchPtr = shared_ptr<rocksdb::WriteBatch>;
   using OnEntry = function<bool(Slice const&, Slice const&)>;
@@ -87,6 +120,10 @@ struct DbStorage {
     COLUMN(pending_transactions);
     COLUMN(aleth_chain);
     COLUMN(aleth_chain_extras);
+    // final chain block number (big endian)->log bloom of the block, only blocks with logs
+    COLUMN(final_chain_log_blooms);
+    // address + topic0 + final chain block number (big endian)->empty, see final_chain::LogIndex
+    COLUMN(final_chain_log_index);
 
 #undef COLUMN
   };
@@ -99,6 +136,7 @@ struct DbStorage {
   const std::string state_db_dir = "state_db";
   DB* db_;
   vector<ColumnFamilyHandle*> handles_;
+  shared_ptr<Cache> block_cache_;
   ReadOptions read_options_;
   WriteOptions write_options_;
   mutex dag_blocks_mutex_;
@@ -107,11 +145,14 @@ struct DbStorage {
   uint32_t db_snapshot_each_n_pbft_block_ = 0;
   uint32_t db_max_snapshots_ = 0;
   uint32_t snapshots_counter = 0;
+  // Guards snapshots_ once the executor runs, snapshots are created and pruned on different threads
+  mutex snapshots_mutex_;
   std::set<uint64_t> snapshots_;
   addr_t node_addr_;
   bool minor_version_changed_ = false;
 
   auto handle(Column const& col) const { return handles_[col.ordinal]; }
+  ColumnFamilyOptions columnOptions(Column const& col, DbConfig const& config);
 
   LOG_OBJECTS_DEFINE;
 
@@ -121,7 +162,7 @@ struct DbStorage {
 
   explicit DbStorage(fs::path const& base_path, uint32_t db_snapshot_each_n_pbft_block = 0,
                      uint32_t db_max_snapshots = 0, uint32_t db_revert_to_period = 0, addr_t node_addr = addr_t(),
-                     bool rebuild = 0);
+                     bool rebuild = 0, DbConfig const& config = {});
   ~DbStorage();
 
   auto const& path() const { return path_; }
@@ -129,7 +170,13 @@ struct DbStorage {
   auto stateDbStoragePath() const { return state_db_path_; }
   static BatchPtr createWriteBatch();
   void commitWriteBatch(BatchPtr const& write_batch);
+  bool isSnapshotPeriod(uint64_t period) const {
+    return db_snapshot_each_n_pbft_block_ > 0 && period % db_snapshot_each_n_pbft_block_ == 0;
+  }
+  // Creates the snapshot if period is a snapshot period, old snapshots are deleted separately by pruneSnapshots
   bool createSnapshot(uint64_t const& period);
+  // Deletes the oldest snapshots over db_max_snapshots
+  void pruneSnapshots();
   void deleteSnapshot(uint64_t const& period);
   void recoverToPeriod(uint64_t const& period);
   void loadSnapshots();
@@ -171,10 +218,9 @@ struct DbStorage {
   // pbft_blocks (head)
   // TODO: I would recommend storing this differently and not in the same db as
   // regular blocks with real hashes. Need remove from DB
-  string getPbftHead(blk_hash_t const& hash);
-  void savePbftHead(blk_hash_t const& hash, string const& pbft_chain_head_str);
-  void addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, std::string const& head_str,
-                          BatchPtr const& write_batch);
+  bytes getPbftHead(blk_hash_t const& hash);
+  void savePbftHead(blk_hash_t const& hash, bytes const& pbft_chain_head);
+  void addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, bytes const& head, BatchPtr const& write_batch);
   // status
   uint64_t getStatusField(StatusDbField const& field);
   void saveStatusField(StatusDbField const& field,
@@ -206,6 +252,8 @@ struct DbStorage {
   void insert(Column const& col, Slice const& k, Slice const& v);
   void remove(Slice key, Column const& column);
   void forEach(Column const& col, OnEntry const& f);
+  // Iterates entries with keys starting from the given one in the key order
+  void forEach(Column const& col, Slice const& from, OnEntry const& f);
 
   bool hasMinorVersionChanged() { return minor_version_changed_; }
 
@@ -224,6 +272,10 @@ struct DbStorage {
 
   inline static Slice toSlice(dev::bytes const& b) { return toSlice(&b); }
 
+  inline static dev::bytesConstRef toBytesConstRef(Slice const& s) {
+    return dev::bytesConstRef(reinterpret_cast<byte const*>(s.data()), s.size());
+  }
+
   template <class N, typename = enable_if_t<is_arithmetic<N>::value>>
   inline static Slice toSlice(N const& n) {
     return Slice(reinterpret_cast<char const*>(&n), sizeof(N));
@@ -305,6 +357,9 @@ struct DbStorage {
     dev::bytesConstRef get_key(uint pos);
     uint size();
     vector<string> execute(bool and_reset = true);
+    // Values are pinned in rocksdb memory (block cache/memtable) instead of being copied, they stay valid as long
+    // as returned slices exist. Keys might point into slices returned by previous call.
+    vector<PinnableSlice> execute_pinned(bool and_reset = true);
     MultiGetQuery& reset();
   };
 };
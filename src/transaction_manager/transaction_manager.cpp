@@ -10,6 +10,7 @@
 #include "network/network.hpp"
 #include "network/rpc/WSServer.h"
 #include "transaction.hpp"
+#include "util/flat_hash.hpp"
 
 using namespace taraxa::net;
 namespace taraxa {
@@ -25,7 +26,7 @@ auto trxComp = [](Transaction const &t1, Transaction const &t2) -> bool {
 
 TransactionManager::TransactionManager(FullNodeConfig const &conf, addr_t node_addr, std::shared_ptr<DbStorage> db,
                                        logger::Logger log_time)
-    : conf_(conf), trx_qu_(node_addr), node_addr_(node_addr), db_(db), log_time_(log_time) {
+    : conf_(conf), trx_qu_(node_addr), node_addr_(node_addr), db_(db), trx_status_(db), log_time_(log_time) {
   LOG_OBJECTS_CREATE("TRXMGR");
   auto trx_count = db_->getStatusField(taraxa::StatusDbField::TrxCount);
   trx_count_.store(trx_count);
@@ -82,23 +83,16 @@ void TransactionManager::verifyQueuedTrxs() {
     }
     // mark invalid
     if (!valid.first) {
-      {
-        uLock lock(mu_for_transactions_);
-        db_->saveTransactionStatus(hash, TransactionStatus::invalid);
-      }
+      trx_status_.compareAndSet(hash, TransactionStatus::in_queue_unverified, TransactionStatus::invalid);
       trx_qu_.removeTransactionFromBuffer(hash);
       LOG(log_wr_) << " Trx: " << hash << "invalid: " << valid.second << std::endl;
       continue;
     }
-    {
-      uLock lock(mu_for_transactions_);
-      auto status = db_->getTransactionStatus(hash);
-      if (status == TransactionStatus::in_queue_unverified) {
-        db_->saveTransactionStatus(hash, TransactionStatus::in_queue_verified);
-        event_transaction_accepted.pub(hash);
-        lock.unlock();
-        trx_qu_.addTransactionToVerifiedQueue(hash, item.second);
-      }
+    if (trx_status_.compareAndSet(hash, TransactionStatus::in_queue_unverified, TransactionStatus::in_queue_verified)
+            .first) {
+      event_transaction_accepted.pub(*item.second);
+      trx_qu_.addTransactionToVerifiedQueue(hash, item.second);
+      event_transaction_verified.pub(hash);
     }
   }
 }
@@ -128,12 +122,22 @@ void TransactionManager::stop() {
   for (auto &t : verifiers_) {
     t.join();
   }
+  trx_status_.flush();
 }
 
 std::unordered_map<trx_hash_t, Transaction> TransactionManager::getVerifiedTrxSnapShot() const {
   return trx_qu_.getVerifiedTrxSnapShot();
 }
 
+std::vector<Transaction> TransactionManager::getVerifiedTrxSnapShotSorted() const {
+  std::vector<Transaction> ret;
+  for (auto &[_, trx] : trx_qu_.getVerifiedTrxSnapShot()) {
+    ret.push_back(std::move(trx));
+  }
+  sort(ret.begin(), ret.end(), trxComp);
+  return ret;
+}
+
 std::pair<size_t, size_t> TransactionManager::getTransactionQueueSize() const {
   return trx_qu_.getTransactionQueueSize();
 }
@@ -170,21 +174,23 @@ bool TransactionManager::saveBlockTransactionAndDeduplicate(DagBlock const &blk,
   if (all_block_trx_hashes.empty()) {
     return true;
   }
-  std::set<trx_hash_t> known_trx_hashes(all_block_trx_hashes.begin(), all_block_trx_hashes.end());
-
+  util::FlatHashSet<trx_hash_t> attached_trx_hashes(some_trxs.size());
   if (!some_trxs.empty()) {
     auto trx_batch = db_->createWriteBatch();
     for (auto const &trx : some_trxs) {
       db_->addTransactionToBatch(trx, trx_batch);
-      known_trx_hashes.erase(trx.getHash());
+      attached_trx_hashes.insert(trx.getHash());
     }
     db_->commitWriteBatch(trx_batch);
   }
 
   bool all_transactions_saved = true;
   trx_hash_t missing_trx;
-  for (auto const &trx : known_trx_hashes) {
-    auto status = db_->getTransactionStatus(trx);
+  for (auto const &trx : all_block_trx_hashes) {
+    if (attached_trx_hashes.count(trx)) {
+      continue;
+    }
+    auto status = trx_status_.get(trx);
     if (status == TransactionStatus::not_seen) {
       all_transactions_saved = false;
       missing_trx = trx;
@@ -193,23 +199,33 @@ bool TransactionManager::saveBlockTransactionAndDeduplicate(DagBlock const &blk,
   }
 
   if (all_transactions_saved) {
-    uLock lock(mu_for_transactions_);
+    // Transactions which were not verified yet are verified before any status is changed, so an invalid block
+    // leaves no trace
+    for (auto const &trx : all_block_trx_hashes) {
+      if (trx_status_.get(trx) == TransactionStatus::in_queue_unverified) {
+        auto valid = verifyTransaction(db_->getTransactionExt(trx)->first);
+        if (!valid.first) {
+          LOG(log_er_) << " Block contains invalid transaction " << trx << " " << valid.second;
+          return false;
+        }
+      }
+    }
     auto trx_batch = db_->createWriteBatch();
+    uint64_t new_in_block_count = 0;
     for (auto const &trx : all_block_trx_hashes) {
-      auto status = db_->getTransactionStatus(trx);
+      auto status = trx_status_.exchange(trx, TransactionStatus::in_block);
       if (status != TransactionStatus::in_block) {
         if (status == TransactionStatus::in_queue_unverified) {
-          auto valid = verifyTransaction(db_->getTransactionExt(trx)->first);
-          if (!valid.first) {
-            LOG(log_er_) << " Block contains invalid transaction " << trx << " " << valid.second;
-            return false;
-          }
-          event_transaction_accepted.pub(trx);
+          event_transaction_accepted.pub(db_->getTransactionExt(trx)->first);
         }
-        trx_count_.fetch_add(1);
+        ++new_in_block_count;
+        // Persisted together with the counter, the table alone would write it with its next group commit only
         db_->addTransactionStatusToBatch(trx_batch, trx, TransactionStatus::in_block);
       }
-      auto trx_count = trx_count_.load();
+    }
+    if (new_in_block_count) {
+      uLock lock(mu_for_trx_count_);
+      auto trx_count = trx_count_.fetch_add(new_in_block_count) + new_in_block_count;
       db_->addStatusFieldToBatch(StatusDbField::TrxCount, trx_count, trx_batch);
       db_->commitWriteBatch(trx_batch);
     }
@@ -247,18 +263,15 @@ std::pair<bool, std::string> TransactionManager::insertTrx(Transaction const &tr
   }
 
   if (verified.first) {
-    uLock lock(mu_for_transactions_);
-    auto status = db_->getTransactionStatus(hash);
-    if (status == TransactionStatus::not_seen) {
+    auto [inserted, status] = trx_status_.compareAndSet(
+        hash, TransactionStatus::not_seen,
+        verify ? TransactionStatus::in_queue_verified : TransactionStatus::in_queue_unverified);
+    if (inserted) {
+      event_transaction_accepted.pub(trx);
+      trx_qu_.insert(trx, verify);
       if (verify) {
-        status = TransactionStatus::in_queue_verified;
-      } else {
-        status = TransactionStatus::in_queue_unverified;
+        event_transaction_verified.pub(hash);
       }
-      db_->saveTransactionStatus(hash, status);
-      event_transaction_accepted.pub(hash);
-      lock.unlock();
-      trx_qu_.insert(trx, verify);
       if (ws_server_) ws_server_->newPendingTransaction(trx.getHash());
       return std::make_pair(true, "");
     } else {
@@ -294,36 +307,31 @@ std::pair<bool, std::string> TransactionManager::insertTrx(Transaction const &tr
  * 3. propose transactions for block A
  * 4. update A, B and C status to seen_in_db
  */
-void TransactionManager::packTrxs(vec_trx_t &to_be_packed_trx, uint16_t max_trx_to_pack) {
+void TransactionManager::packTrxs(vec_trx_t &to_be_packed_trx, uint16_t max_trx_to_pack,
+                                  std::function<bool(trx_hash_t const &)> const &filter) {
   to_be_packed_trx.clear();
   std::list<Transaction> list_trxs;
 
-  auto verified_trx = trx_qu_.moveVerifiedTrxSnapShot(max_trx_to_pack);
+  auto verified_trx = trx_qu_.moveVerifiedTrxSnapShot(max_trx_to_pack, filter);
 
-  bool changed = false;
   auto trx_batch = db_->createWriteBatch();
-  {
-    uLock lock(mu_for_transactions_);
-    for (auto const &i : verified_trx) {
-      trx_hash_t const &hash = i.first;
-      Transaction const &trx = i.second;
-      auto status = db_->getTransactionStatus(hash);
-      if (status == TransactionStatus::in_queue_verified) {
-        // Skip if transaction is already in existing block
-        db_->addTransactionStatusToBatch(trx_batch, hash, TransactionStatus::in_block);
-        trx_count_.fetch_add(1);
-        changed = true;
-        LOG(log_dg_) << "Trx: " << hash << " ready to pack" << std::endl;
-        // update transaction_status
-        list_trxs.push_back(trx);
-      }
+  for (auto const &i : verified_trx) {
+    trx_hash_t const &hash = i.first;
+    Transaction const &trx = i.second;
+    // Skip if transaction is already in existing block
+    if (trx_status_.compareAndSet(hash, TransactionStatus::in_queue_verified, TransactionStatus::in_block).first) {
+      db_->addTransactionStatusToBatch(trx_batch, hash, TransactionStatus::in_block);
+      LOG(log_dg_) << "Trx: " << hash << " ready to pack" << std::endl;
+      // update transaction_status
+      list_trxs.push_back(trx);
     }
+  }
 
-    if (changed) {
-      auto trx_count = trx_count_.load();
-      db_->addStatusFieldToBatch(StatusDbField::TrxCount, trx_count, trx_batch);
-      db_->commitWriteBatch(trx_batch);
-    }
+  if (!list_trxs.empty()) {
+    uLock lock(mu_for_trx_count_);
+    auto trx_count = trx_count_.fetch_add(list_trxs.size()) + list_trxs.size();
+    db_->addStatusFieldToBatch(StatusDbField::TrxCount, trx_count, trx_batch);
+    db_->commitWriteBatch(trx_batch);
   }
 
   if (list_trxs.size() == 0) {
@@ -7,6 +7,7 @@
 #include "transaction.hpp"
 #include "transaction_queue.hpp"
 #include "transaction_status.hpp"
+#include "transaction_status_table.hpp"
 #include "util/simple_event.hpp"
 
 namespace taraxa {
@@ -29,7 +30,9 @@ class WSServer;
 
 class TransactionManager : public std::enable_shared_from_this<TransactionManager> {
  public:
-  util::SimpleEvent<trx_hash_t> const event_transaction_accepted{};
+  util::SimpleEvent<Transaction> const event_transaction_accepted{};
+  // Published after a transaction is added to the verified queue, i.e. it can be packed
+  util::SimpleEvent<trx_hash_t> const event_transaction_verified{};
 
   using uLock = std::unique_lock<std::mutex>;
   enum class VerifyMode : uint8_t { normal, skip_verify_sig };
@@ -37,7 +40,7 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   TransactionManager(FullNodeConfig const &conf, addr_t node_addr, std::shared_ptr<DbStorage> db,
                      logger::Logger log_time);
   explicit TransactionManager(std::shared_ptr<DbStorage> db, addr_t node_addr)
-      : db_(db), conf_(), trx_qu_(node_addr), node_addr_(node_addr) {
+      : db_(db), trx_status_(db), conf_(), trx_qu_(node_addr), node_addr_(node_addr) {
     LOG_OBJECTS_CREATE("TRXMGR");
   }
   std::shared_ptr<TransactionManager> getShared() {
@@ -60,9 +63,9 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   void setPendingBlock(std::shared_ptr<aleth::PendingBlock> pending_block) {
     pending_block_ = pending_block;
     filter_api_ = aleth::NewFilterAPI();
-    event_transaction_accepted.sub([=](auto const &h) {
-      pending_block_->add_transactions(vector{h});
-      filter_api_->note_pending_transactions(vector{h});
+    event_transaction_accepted.sub([=](auto const &trx) {
+      pending_block_->add_transactions(vector{trx});
+      filter_api_->note_pending_transactions(vector{trx.getHash()});
     });
   }
   auto getPendingBlock() const { return pending_block_; }
@@ -71,7 +74,9 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   /**
    * The following function will require a lock for verified qu
    */
-  void packTrxs(vec_trx_t &to_be_packed_trx, uint16_t max_trx_to_pack = 0);
+  // Only transactions accepted by filter (all if it's empty) are packed
+  void packTrxs(vec_trx_t &to_be_packed_trx, uint16_t max_trx_to_pack = 0,
+                std::function<bool(trx_hash_t const &)> const &filter = {});
   void setVerifyMode(VerifyMode mode) { mode_ = mode; }
 
   // Insert new transaction to unverified queue or if verify flag true
@@ -83,13 +88,19 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   std::pair<bool, std::string> verifyTransaction(Transaction const &trx) const;
 
   std::unordered_map<trx_hash_t, Transaction> getVerifiedTrxSnapShot() const;
+  // All the verified transactions, ordered the same way as the new ones for gossiping
+  std::vector<Transaction> getVerifiedTrxSnapShotSorted() const;
   std::vector<taraxa::bytes> getNewVerifiedTrxSnapShotSerialized();
   std::pair<size_t, size_t> getTransactionQueueSize() const;
+  bool hasVerifiedTrx(std::function<bool(trx_hash_t const &)> const &filter) const {
+    return trx_qu_.hasVerifiedTrx(filter);
+  }
 
   // Verify transactions in broadcasted blocks
   bool verifyBlockTransactions(DagBlock const &blk, std::vector<Transaction> const &trxs);
 
   std::shared_ptr<std::pair<Transaction, taraxa::bytes>> getTransaction(trx_hash_t const &hash) const;
+  TransactionStatus getTransactionStatus(trx_hash_t const &hash) { return trx_status_.get(hash); }
   unsigned long getTransactionCount() const;
   // Received block means these trxs are packed by others
 
@@ -104,6 +115,7 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   VerifyMode mode_ = VerifyMode::normal;
   std::atomic<bool> stopped_ = true;
   std::shared_ptr<DbStorage> db_ = nullptr;
+  TransactionStatusTable trx_status_;
   TransactionQueue trx_qu_;
   std::atomic<unsigned long> trx_count_ = 0;
   FullNodeConfig conf_;
@@ -117,7 +129,8 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   std::shared_ptr<aleth::FilterAPI> filter_api_;
 
   mutable std::mutex mu_for_nonce_table_;
-  mutable std::mutex mu_for_transactions_;
+  // Keeps TrxCount written to the db in the same order as trx_count_ is incremented
+  mutable std::mutex mu_for_trx_count_;
   LOG_OBJECTS_DEFINE;
 };
 }  // namespace taraxa
@@ -1,5 +1,6 @@
 #include "transaction_queue.hpp"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -33,7 +34,7 @@ void TransactionQueue::insert(Transaction const &trx, bool verify) {
   if (verify) {
     uLock lock(shared_mutex_for_verified_qu_);
     verified_trxs_[trx.getHash()] = iter;
-    new_verified_transactions_ = true;
+    addNewVerifiedTransaction(hash);
   } else {
     uLock lock(shared_mutex_for_unverified_qu_);
     unverified_hash_qu_.emplace_back(std::make_pair(hash, iter));
@@ -68,7 +69,7 @@ void TransactionQueue::removeTransactionFromBuffer(trx_hash_t const &hash) {
 void TransactionQueue::addTransactionToVerifiedQueue(trx_hash_t const &hash, std::list<Transaction>::iterator iter) {
   uLock lock(shared_mutex_for_verified_qu_);
   verified_trxs_[hash] = iter;
-  new_verified_transactions_ = true;
+  addNewVerifiedTransaction(hash);
 }
 
 // The caller is responsible for storing the transaction to db!
@@ -117,20 +118,32 @@ std::unordered_map<trx_hash_t, Transaction> TransactionQueue::getVerifiedTrxSnap
 
 std::vector<Transaction> TransactionQueue::getNewVerifiedTrxSnapShot() {
   std::vector<Transaction> verified_trxs;
-  sharedLock lock(shared_mutex_for_verified_qu_);
-  {
-    if (new_verified_transactions_) {
-      new_verified_transactions_ = false;
-      std::transform(verified_trxs_.begin(), verified_trxs_.end(), std::back_inserter(verified_trxs),
-                     [](std::pair<const taraxa::trx_hash_t, taraxa::TransactionQueue::listIter> const &trx) {
-                       return *(trx.second);
-                     });
-      LOG(log_dg_) << "Get: " << verified_trxs.size() << "verified trx out for gossiping " << std::endl;
+  uLock lock(shared_mutex_for_verified_qu_);
+  verified_trxs.reserve(new_verified_trxs_.size());
+  for (auto const &hash : new_verified_trxs_) {
+    // Transaction might have been packed in the meantime
+    if (auto it = verified_trxs_.find(hash); it != verified_trxs_.end()) {
+      verified_trxs.emplace_back(*(it->second));
     }
   }
+  new_verified_trxs_.clear();
+  if (!verified_trxs.empty()) {
+    LOG(log_dg_) << "Get: " << verified_trxs.size() << " new verified trx out for gossiping " << std::endl;
+  }
   return verified_trxs;
 }
 
+void TransactionQueue::addNewVerifiedTransaction(trx_hash_t const &hash) {
+  new_verified_trxs_.emplace_back(hash);
+  // Nobody might be collecting new transactions (e.g. gossiping disabled), drop the ones which are no longer
+  // in the verified queue so that size stays proportional to the queue
+  if (new_verified_trxs_.size() > 2 * verified_trxs_.size() + 1000) {
+    new_verified_trxs_.erase(std::remove_if(new_verified_trxs_.begin(), new_verified_trxs_.end(),
+                                            [this](auto const &h) { return !verified_trxs_.count(h); }),
+                             new_verified_trxs_.end());
+  }
+}
+
 // search from queued_trx_
 std::shared_ptr<Transaction> TransactionQueue::getTransaction(trx_hash_t const &hash) const {
   {
@@ -143,11 +156,12 @@ std::shared_ptr<Transaction> TransactionQueue::getTransaction(trx_hash_t const &
   return nullptr;
 }
 
-std::unordered_map<trx_hash_t, Transaction> TransactionQueue::moveVerifiedTrxSnapShot(uint16_t max_trx_to_pack) {
+std::unordered_map<trx_hash_t, Transaction> TransactionQueue::moveVerifiedTrxSnapShot(
+    uint16_t max_trx_to_pack, std::function<bool(trx_hash_t const &)> const &filter) {
   std::unordered_map<trx_hash_t, Transaction> res;
   {
     uLock lock(shared_mutex_for_verified_qu_);
-    if (max_trx_to_pack == 0) {
+    if (max_trx_to_pack == 0 && !filter) {
       for (auto const &trx : verified_trxs_) {
         res[trx.first] = *(trx.second);
       }
@@ -155,7 +169,11 @@ std::unordered_map<trx_hash_t, Transaction> TransactionQueue::moveVerifiedTrxSna
     } else {
       auto it = verified_trxs_.begin();
       uint16_t counter = 0;
-      while (it != verified_trxs_.end() && max_trx_to_pack != counter) {
+      while (it != verified_trxs_.end() && (max_trx_to_pack == 0 || max_trx_to_pack != counter)) {
+        if (filter && !filter(it->first)) {
+          ++it;
+          continue;
+        }
         res[it->first] = *(it->second);
         it = verified_trxs_.erase(it);
         counter++;
@@ -175,6 +193,11 @@ std::unordered_map<trx_hash_t, Transaction> TransactionQueue::moveVerifiedTrxSna
   return std::move(res);
 }
 
+bool TransactionQueue::hasVerifiedTrx(std::function<bool(trx_hash_t const &)> const &filter) const {
+  sharedLock lock(shared_mutex_for_verified_qu_);
+  return std::any_of(verified_trxs_.begin(), verified_trxs_.end(), [&](auto const &trx) { return filter(trx.first); });
+}
+
 unsigned long TransactionQueue::getVerifiedTrxCount() const {
   sharedLock lock(shared_mutex_for_verified_qu_);
   return verified_trxs_.size();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "config/config.hpp"
 #include "transaction.hpp"
 
@@ -24,9 +26,13 @@ class TransactionQueue {
   std::pair<trx_hash_t, listIter> getUnverifiedTransaction();
   void removeTransactionFromBuffer(trx_hash_t const &hash);
   void addTransactionToVerifiedQueue(trx_hash_t const &hash, std::list<Transaction>::iterator);
-  std::unordered_map<trx_hash_t, Transaction> moveVerifiedTrxSnapShot(uint16_t max_trx_to_pack = 0);
+  // Only transactions accepted by filter (all if it's empty) are moved, the rest stay in the queue
+  std::unordered_map<trx_hash_t, Transaction> moveVerifiedTrxSnapShot(
+      uint16_t max_trx_to_pack = 0, std::function<bool(trx_hash_t const &)> const &filter = {});
   std::unordered_map<trx_hash_t, Transaction> getVerifiedTrxSnapShot() const;
   std::pair<size_t, size_t> getTransactionQueueSize() const;
+  // Whether any verified transaction is accepted by filter, i.e. moveVerifiedTrxSnapShot would move something
+  bool hasVerifiedTrx(std::function<bool(trx_hash_t const &)> const &filter) const;
   std::vector<Transaction> getNewVerifiedTrxSnapShot();
   std::unordered_map<trx_hash_t, Transaction> removeBlockTransactionsFromQueue(vec_trx_t const &all_block_trxs);
   unsigned long getVerifiedTrxCount() const;
@@ -38,8 +44,11 @@ class TransactionQueue {
   using upgradableLock = boost::upgrade_lock<boost::shared_mutex>;
   using upgradeLock = boost::upgrade_to_unique_lock<boost::shared_mutex>;
   addr_t getFullNodeAddress() const;
+  // Must be called with shared_mutex_for_verified_qu_ locked
+  void addNewVerifiedTransaction(trx_hash_t const &hash);
   std::atomic<bool> stopped_ = true;
-  bool new_verified_transactions_ = true;
+  // Transactions verified since the last getNewVerifiedTrxSnapShot call
+  std::vector<trx_hash_t> new_verified_trxs_;
 
   std::list<Transaction> trx_buffer_;
   std::unordered_map<trx_hash_t, listIter> queued_trxs_;  // all trx
@@ -0,0 +1,150 @@
+#include "transaction_status_table.hpp"
+
+namespace taraxa {
+
+TransactionStatusTable::TransactionStatusTable(std::shared_ptr<DbStorage> db, size_t capacity)
+    : db_(std::move(db)), shard_capacity_(capacity / c_shards_num) {}
+
+TransactionStatusTable::~TransactionStatusTable() { flush(); }
+
+TransactionStatus TransactionStatusTable::get(trx_hash_t const &hash) {
+  auto &s = shard(hash);
+  std::lock_guard lock(s.mu);
+  auto entry = find(s, hash);
+  return entry ? entry->status : TransactionStatus::not_seen;
+}
+
+std::pair<bool, TransactionStatus> TransactionStatusTable::compareAndSet(trx_hash_t const &hash,
+                                                                         TransactionStatus expected,
+                                                                         TransactionStatus desired) {
+  auto &s = shard(hash);
+  {
+    std::lock_guard lock(s.mu);
+    auto entry = find(s, hash);
+    auto const current = entry ? entry->status : TransactionStatus::not_seen;
+    if (current != expected) {
+      return {false, current};
+    }
+    set(s, hash, entry, desired);
+  }
+  flushIfNeeded();
+  return {true, expected};
+}
+
+TransactionStatus TransactionStatusTable::exchange(trx_hash_t const &hash, TransactionStatus desired) {
+  auto &s = shard(hash);
+  TransactionStatus current;
+  {
+    std::lock_guard lock(s.mu);
+    auto entry = find(s, hash);
+    current = entry ? entry->status : TransactionStatus::not_seen;
+    if (current == desired) {
+      return current;
+    }
+    set(s, hash, entry, desired);
+  }
+  flushIfNeeded();
+  return current;
+}
+
+void TransactionStatusTable::flush() {
+  std::lock_guard lock(flush_mu_);
+  flushLocked();
+}
+
+TransactionStatusTable::Entry *TransactionStatusTable::find(Shard &shard, trx_hash_t const &hash) {
+  if (auto it = shard.entries.find(hash); it != shard.entries.end()) {
+    return &it->second;
+  }
+  auto const status = db_->getTransactionStatus(hash);
+  if (status == TransactionStatus::not_seen) {
+    return nullptr;
+  }
+  auto &entry = shard.entries[hash] = Entry{status};
+  if (isFinal(status)) {
+    shard.evictable.push_back(hash);
+    evict(shard);
+  }
+  return &entry;
+}
+
+void TransactionStatusTable::set(Shard &shard, trx_hash_t const &hash, Entry *entry, TransactionStatus status) {
+  if (!entry) {
+    entry = &(shard.entries[hash] = Entry{status});
+  }
+  entry->status = status;
+  ++entry->version;
+  if (!entry->dirty) {
+    entry->dirty = true;
+    shard.dirty.push_back(hash);
+    dirty_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void TransactionStatusTable::evict(Shard &shard) {
+  while (shard.entries.size() > shard_capacity_ && !shard.evictable.empty()) {
+    // Entry might have been changed (or evicted already) since it was added to the evictable ones
+    if (auto it = shard.entries.find(shard.evictable.front());
+        it != shard.entries.end() && !it->second.dirty && isFinal(it->second.status)) {
+      shard.entries.erase(it);
+    }
+    shard.evictable.pop_front();
+  }
+}
+
+void TransactionStatusTable::flushIfNeeded() {
+  if (dirty_count_.load(std::memory_order_relaxed) < c_flush_batch_size) {
+    return;
+  }
+  // Someone else is already flushing, changes made meanwhile go to the next batch
+  if (std::unique_lock lock(flush_mu_, std::try_to_lock); lock.owns_lock()) {
+    flushLocked();
+  }
+}
+
+void TransactionStatusTable::flushLocked() {
+  // Shards are not locked during the commit, so a status might be changed meanwhile, including by a caller which
+  // persists it on its own (e.g. in_block together with the block) and might commit before this batch. Such entries
+  // stay dirty, so the newer status is written again by the next batch
+  std::array<std::vector<std::pair<trx_hash_t, uint64_t>>, c_shards_num> flushed;
+  auto batch = db_->createWriteBatch();
+  size_t flushed_count = 0;
+  for (size_t i = 0; i < c_shards_num; ++i) {
+    auto &s = shards_[i];
+    std::lock_guard lock(s.mu);
+    flushed[i].reserve(s.dirty.size());
+    for (auto const &hash : s.dirty) {
+      auto const &entry = s.entries.at(hash);
+      db_->addTransactionStatusToBatch(batch, hash, entry.status);
+      flushed[i].emplace_back(hash, entry.version);
+    }
+    s.dirty.clear();
+    flushed_count += flushed[i].size();
+  }
+  if (!flushed_count) {
+    return;
+  }
+  db_->commitWriteBatch(batch);
+  size_t persisted_count = 0;
+  for (size_t i = 0; i < c_shards_num; ++i) {
+    auto &s = shards_[i];
+    std::lock_guard lock(s.mu);
+    for (auto const &[hash, version] : flushed[i]) {
+      auto &entry = s.entries.at(hash);
+      if (entry.version != version) {
+        s.dirty.push_back(hash);
+        continue;
+      }
+      entry.dirty = false;
+      ++persisted_count;
+      // Only entries which are in the db may be evicted
+      if (isFinal(entry.status)) {
+        s.evictable.push_back(hash);
+      }
+    }
+    evict(s);
+  }
+  dirty_count_.fetch_sub(persisted_count, std::memory_order_relaxed);
+}
+
+}  // namespace taraxa
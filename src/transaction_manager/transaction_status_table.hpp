@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/db_storage.hpp"
+#include "transaction_status.hpp"
+
+namespace taraxa {
+
+/**
+ * Source of truth for statuses of recent transactions.
+ *
+ * Statuses live in a map split into shards by the first hash byte, each shard has its own mutex. Transitions are
+ * compare-and-set so concurrent ingestion paths agree on which one moved a transaction forward without any global
+ * lock. Changes are persisted to the trx_status column in group commit batches: the thread which makes the number of
+ * unpersisted changes reach c_flush_batch_size writes all of them in a single batch.
+ *
+ * Statuses missing in the map are loaded from the db on first access. Persisted final statuses (in_block, invalid)
+ * are evicted once a shard exceeds its share of the capacity, statuses of queued transactions are always kept.
+ */
+class TransactionStatusTable {
+ public:
+  static constexpr size_t c_shards_num = 16;
+  static constexpr size_t c_flush_batch_size = 256;
+
+  explicit TransactionStatusTable(std::shared_ptr<DbStorage> db, size_t capacity = 100000);
+  ~TransactionStatusTable();
+
+  TransactionStatus get(trx_hash_t const &hash);
+  // Sets the status if the current one is expected, returns whether it was set and the status before the call
+  std::pair<bool, TransactionStatus> compareAndSet(trx_hash_t const &hash, TransactionStatus expected,
+                                                   TransactionStatus desired);
+  // Sets the status, returns the status before the call
+  TransactionStatus exchange(trx_hash_t const &hash, TransactionStatus desired);
+  // Persists all the changes
+  void flush();
+
+ private:
+  struct Entry {
+    TransactionStatus status;
+    bool dirty = false;
+    // Incremented by every change, tells whether the status was changed while a batch with it was being committed
+    uint64_t version = 0;
+  };
+
+  struct Shard {
+    std::mutex mu;
+    std::unordered_map<trx_hash_t, Entry> entries;
+    std::vector<trx_hash_t> dirty;
+    std::deque<trx_hash_t> evictable;
+  };
+
+  static bool isFinal(TransactionStatus status) {
+    return status == TransactionStatus::in_block || status == TransactionStatus::invalid;
+  }
+  Shard &shard(trx_hash_t const &hash) { return shards_[hash[0] % c_shards_num]; }
+
+  // Following methods must be called with the shard mutex locked
+  Entry *find(Shard &shard, trx_hash_t const &hash);
+  void set(Shard &shard, trx_hash_t const &hash, Entry *entry, TransactionStatus status);
+  void evict(Shard &shard);
+
+  void flushIfNeeded();
+  void flushLocked();
+
+  std::shared_ptr<DbStorage> const db_;
+  size_t const shard_capacity_;
+  std::array<Shard, c_shards_num> shards_;
+  std::atomic<size_t> dirty_count_ = 0;
+  std::mutex flush_mu_;
+};
+
+}  // namespace taraxa
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * Hash function of flat hash containers.
+ *
+ * dev::FixedHash keys are uniformly distributed already, so their leading bytes are used as the hash value directly
+ * with no rehashing. Integers and pointers (e.g. boost graph vertex descriptors) are mixed, as their low bits are
+ * usually sequential or zero because of alignment.
+ */
+struct FlatHash {
+  template <unsigned N>
+  size_t operator()(dev::FixedHash<N> const &key) const {
+    static_assert(N >= sizeof(size_t), "FixedHash must contain at least size_t bytes");
+    size_t ret;
+    std::memcpy(&ret, key.data(), sizeof(ret));
+    return ret;
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T> || std::is_pointer_v<T>>>
+  size_t operator()(T key) const {
+    uint64_t x;
+    if constexpr (std::is_pointer_v<T>) {
+      x = reinterpret_cast<uintptr_t>(key);
+    } else {
+      x = static_cast<uint64_t>(key);
+    }
+    // Finalizer of MurmurHash3
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+};
+
+/**
+ * Open addressing (linear probing) hash map storing keys and values in flat arrays.
+ *
+ * Meant for short lived per-block work sets: a single allocation per array instead of a node per element, lookups
+ * touch contiguous memory. Load factor is kept at most 1/2. Elements can't be erased, pointers returned by find and
+ * operator[] are invalidated by inserts.
+ */
+template <typename Key, typename Value, typename Hash = FlatHash>
+class FlatHashMap {
+ public:
+  explicit FlatHashMap(size_t expected_size = 0) {
+    if (expected_size) {
+      reserve(expected_size);
+    }
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void reserve(size_t expected_size) {
+    size_t capacity = c_min_capacity;
+    while (capacity < expected_size * 2) {
+      capacity <<= 1;
+    }
+    if (capacity > keys_.size()) {
+      rehash(capacity);
+    }
+  }
+
+  // Keeps the memory
+  void clear() {
+    std::fill(used_.begin(), used_.end(), false);
+    size_ = 0;
+  }
+
+  // Returns the value of the key and whether it was inserted, value of an inserted key is default constructed
+  std::pair<Value *, bool> try_emplace(Key const &key) {
+    if ((size_ + 1) * 2 > keys_.size()) {
+      rehash(keys_.empty() ? c_min_capacity : keys_.size() * 2);
+    }
+    auto i = index(key);
+    for (; used_[i]; i = (i + 1) & mask_) {
+      if (keys_[i] == key) {
+        return {&values_[i], false};
+      }
+    }
+    used_[i] = true;
+    keys_[i] = key;
+    values_[i] = Value();
+    ++size_;
+    return {&values_[i], true};
+  }
+
+  Value &operator[](Key const &key) { return *try_emplace(key).first; }
+
+  Value *find(Key const &key) { return const_cast<Value *>(std::as_const(*this).find(key)); }
+  Value const *find(Key const &key) const {
+    if (keys_.empty()) {
+      return nullptr;
+    }
+    for (auto i = index(key); used_[i]; i = (i + 1) & mask_) {
+      if (keys_[i] == key) {
+        return &values_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  size_t count(Key const &key) const { return find(key) != nullptr; }
+
+  template <typename F>
+  void forEach(F &&f) const {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      if (used_[i]) {
+        f(keys_[i], values_[i]);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t c_min_capacity = 16;
+
+  size_t index(Key const &key) const { return Hash()(key) & mask_; }
+
+  void rehash(size_t capacity) {
+    std::vector<Key> keys(capacity);
+    std::vector<Value> values(capacity);
+    std::vector<uint8_t> used(capacity);
+    std::swap(keys, keys_);
+    std::swap(values, values_);
+    std::swap(used, used_);
+    mask_ = capacity - 1;
+    for (size_t j = 0; j < keys.size(); ++j) {
+      if (!used[j]) {
+        continue;
+      }
+      auto i = index(keys[j]);
+      while (used_[i]) {
+        i = (i + 1) & mask_;
+      }
+      used_[i] = true;
+      keys_[i] = std::move(keys[j]);
+      values_[i] = std::move(values[j]);
+    }
+  }
+
+  std::vector<Key> keys_;
+  std::vector<Value> values_;
+  std::vector<uint8_t> used_;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+// Set counterpart of FlatHashMap, see its description
+template <typename Key, typename Hash = FlatHash>
+class FlatHashSet {
+  struct Empty {};
+
+ public:
+  explicit FlatHashSet(size_t expected_size = 0) : map_(expected_size) {}
+  template <typename It>
+  FlatHashSet(It begin, It end) : map_(std::distance(begin, end)) {
+    for (; begin != end; ++begin) {
+      insert(*begin);
+    }
+  }
+
+  size_t size() const { return map_.size(); }
+  bool empty() const { return map_.empty(); }
+  void reserve(size_t expected_size) { map_.reserve(expected_size); }
+  void clear() { map_.clear(); }
+
+  // Returns whether the key was inserted
+  bool insert(Key const &key) { return map_.try_emplace(key).second; }
+  size_t count(Key const &key) const { return map_.count(key); }
+
+  template <typename F>
+  void forEach(F &&f) const {
+    map_.forEach([&](auto const &key, auto const &) { f(key); });
+  }
+
+ private:
+  FlatHashMap<Key, Empty, Hash> map_;
+};
+
+}  // namespace taraxa::util
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace taraxa::util::rotating_bloom_filter {
+using namespace std;
+
+/**
+ * Probabilistic set of recently seen hashes with bounded memory.
+ *
+ * Two bloom filter generations are kept: items are inserted into the current one and looked up in both. Once the
+ * current generation holds `items_per_generation` items (or is older than `max_generation_age`, if set) the older
+ * generation is wiped and becomes the current one, so an item is remembered for at least one full generation.
+ *
+ * Lookups and inserts are lock-free (atomic bit operations), only the rotation and insertIfNew are serialized. An
+ * insert racing with a rotation may get lost, which results in a false negative - callers must treat the filter as a
+ * hint only.
+ *
+ * Key is expected to be a uniformly distributed hash (e.g. dev::FixedHash) exposing data() and a static size >= 16,
+ * its leading bytes are used directly as the hash values (double hashing), no rehashing is done.
+ */
+template <typename Key>
+class RotatingBloomFilter {
+  static_assert(Key::size >= 2 * sizeof(uint64_t), "Key must contain at least 16 bytes");
+
+  struct Generation {
+    unique_ptr<atomic<uint64_t>[]> words;
+    atomic<uint64_t> items_count = 0;
+    atomic<int64_t> created_at = 0;
+  };
+
+ public:
+  using clock = chrono::steady_clock;
+
+  RotatingBloomFilter(uint64_t items_per_generation, double false_positive_rate,
+                      chrono::milliseconds max_generation_age = chrono::milliseconds::zero())
+      : items_per_generation_(max<uint64_t>(items_per_generation, 1)), max_generation_age_(max_generation_age) {
+    false_positive_rate = min(max(false_positive_rate, 1e-9), 0.5);
+    auto const ln2 = log(2.0);
+    // Optimal number of bits and hash functions for requested false positive rate
+    auto bits = ceil(-static_cast<double>(items_per_generation_) * log(false_positive_rate) / (ln2 * ln2));
+    words_count_ = max<uint64_t>(static_cast<uint64_t>(ceil(bits / 64)), 1);
+    bits_count_ = words_count_ * 64;
+    auto const hashes = round(static_cast<double>(bits_count_) / items_per_generation_ * ln2);
+    hashes_count_ = max<uint32_t>(static_cast<uint32_t>(hashes), 1);
+    for (auto &generation : generations_) {
+      generation.words.reset(new atomic<uint64_t>[words_count_]);
+      reset(generation);
+    }
+  }
+
+  RotatingBloomFilter(RotatingBloomFilter const &) = delete;
+  RotatingBloomFilter &operator=(RotatingBloomFilter const &) = delete;
+
+  bool contains(Key const &key) const {
+    auto const [h1, h2] = hashes(key);
+    return contains(generations_[0], h1, h2) || contains(generations_[1], h1, h2);
+  }
+
+  // Kept for drop-in compatibility with ExpirationCache
+  size_t count(Key const &key) const { return contains(key) ? 1 : 0; }
+
+  void insert(Key const &key) {
+    auto const [h1, h2] = hashes(key);
+    auto &generation = generations_[current_.load(memory_order_acquire)];
+    for (uint32_t i = 0; i < hashes_count_; ++i) {
+      auto const bit = (h1 + i * h2) % bits_count_;
+      generation.words[bit / 64].fetch_or(uint64_t(1) << (bit % 64), memory_order_relaxed);
+    }
+    auto const items_count = generation.items_count.fetch_add(1, memory_order_relaxed) + 1;
+    if (items_count >= items_per_generation_ || isExpired(generation)) {
+      rotate();
+    }
+  }
+
+  // Inserts the key unless it is already contained, returns whether it was inserted. Calls are serialized, so out of
+  // concurrent calls for the same key exactly one returns true
+  bool insertIfNew(Key const &key) {
+    unique_lock lock(insert_if_new_mu_);
+    if (contains(key)) {
+      return false;
+    }
+    insert(key);
+    return true;
+  }
+
+  void clear() {
+    unique_lock lock(rotation_mu_);
+    for (auto &generation : generations_) {
+      reset(generation);
+    }
+  }
+
+  uint64_t bitsPerGeneration() const { return bits_count_; }
+  uint32_t hashesCount() const { return hashes_count_; }
+  size_t memoryUsage() const { return sizeof(*this) + generations_.size() * words_count_ * sizeof(uint64_t); }
+
+ private:
+  static pair<uint64_t, uint64_t> hashes(Key const &key) {
+    uint64_t h1, h2;
+    memcpy(&h1, key.data(), sizeof(h1));
+    memcpy(&h2, key.data() + sizeof(h1), sizeof(h2));
+    // Odd step so that consecutive probes never collapse onto the same bit
+    return {h1, h2 | 1};
+  }
+
+  bool contains(Generation const &generation, uint64_t h1, uint64_t h2) const {
+    for (uint32_t i = 0; i < hashes_count_; ++i) {
+      auto const bit = (h1 + i * h2) % bits_count_;
+      if (!(generation.words[bit / 64].load(memory_order_relaxed) & (uint64_t(1) << (bit % 64)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool isExpired(Generation const &generation) const {
+    if (max_generation_age_ == chrono::milliseconds::zero()) {
+      return false;
+    }
+    return clock::now().time_since_epoch().count() - generation.created_at.load(memory_order_relaxed) >
+           chrono::duration_cast<clock::duration>(max_generation_age_).count();
+  }
+
+  void rotate() {
+    unique_lock lock(rotation_mu_, try_to_lock);
+    if (!lock.owns_lock()) {
+      // Some other thread is already rotating
+      return;
+    }
+    auto const current = current_.load(memory_order_relaxed);
+    auto &generation = generations_[current];
+    if (generation.items_count.load(memory_order_relaxed) < items_per_generation_ && !isExpired(generation)) {
+      return;
+    }
+    auto const next = current ^ 1;
+    reset(generations_[next]);
+    current_.store(next, memory_order_release);
+  }
+
+  void reset(Generation &generation) {
+    for (uint64_t i = 0; i < words_count_; ++i) {
+      generation.words[i].store(0, memory_order_relaxed);
+    }
+    generation.items_count.store(0, memory_order_relaxed);
+    generation.created_at.store(clock::now().time_since_epoch().count(), memory_order_relaxed);
+  }
+
+  uint64_t const items_per_generation_;
+  chrono::milliseconds const max_generation_age_;
+  uint64_t words_count_ = 0;
+  uint64_t bits_count_ = 0;
+  uint32_t hashes_count_ = 0;
+  array<Generation, 2> generations_;
+  atomic<uint8_t> current_ = 0;
+  mutex rotation_mu_;
+  mutex insert_if_new_mu_;
+};
+
+}  // namespace taraxa::util::rotating_bloom_filter
+
+namespace taraxa::util {
+using rotating_bloom_filter::RotatingBloomFilter;
+}
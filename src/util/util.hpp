@@ -13,10 +13,12 @@
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <optional>
 #include <regex>
 #include <streambuf>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "common/types.hpp"
@@ -434,3 +436,62 @@ class ExpirationCacheMap {
   uint32_t delete_step_;
   mutable boost::shared_mutex mtx_;
 };
+
+/**
+ * Thread safe LRU cache bounded by the total weight of its values (e.g. their size in bytes). Every key has exactly
+ * one position in the recency order, a value heavier than the whole bound is not cached.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class LruCache {
+ public:
+  explicit LruCache(size_t max_weight) : max_weight_(max_weight) {}
+
+  std::optional<Value> get(Key const &key) {
+    std::unique_lock lck(mtx_);
+    auto it = index_.find(key);
+    if (it == index_.end()) return std::nullopt;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->value;
+  }
+
+  void put(Key const &key, Value value, size_t weight) {
+    std::unique_lock lck(mtx_);
+    if (auto it = index_.find(key); it != index_.end()) {
+      weight_ -= it->second->weight;
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    if (weight > max_weight_) return;
+    entries_.push_front({key, std::move(value), weight});
+    index_[key] = entries_.begin();
+    weight_ += weight;
+    while (weight_ > max_weight_) {
+      weight_ -= entries_.back().weight;
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+  }
+
+  size_t size() const {
+    std::unique_lock lck(mtx_);
+    return entries_.size();
+  }
+
+  size_t weight() const {
+    std::unique_lock lck(mtx_);
+    return weight_;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Value value;
+    size_t weight;
+  };
+  size_t const max_weight_;
+  size_t weight_ = 0;
+  // Most recently used first
+  std::list<Entry> entries_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+  mutable std::mutex mtx_;
+};
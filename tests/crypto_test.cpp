@@ -5,6 +5,7 @@
 #include <libdevcrypto/Common.h>
 #include <openssl/bn.h>
 
+#include <ctime>
 #include <iostream>
 #include <string>
 
@@ -59,6 +60,29 @@ TEST_F(CryptoTest, VerifierWesolowski) {
   EXPECT_FALSE(verifier(sol3));
 }
 
+TEST_F(CryptoTest, vdf_wesolowski) {
+  dev::bytes const N = dev::asBytes("c7a1d3b5e9f0b1c2d3e4f5a6b7c8d9e0f1a2b3c4d5e6f7a8b9c0d1e2f3a4b5c7");
+  dev::bytes const msg{97};
+  std::atomic_bool cancelled = false;
+  auto const sol = proveWesolowski(100, 10, msg, N, cancelled);
+  ASSERT_TRUE(sol.has_value());
+  EXPECT_TRUE(verifyWesolowski(100, 10, msg, N, *sol));
+
+  EXPECT_FALSE(verifyWesolowski(100, 10, {98}, N, *sol));
+  EXPECT_FALSE(verifyWesolowski(100, 11, msg, N, *sol));
+  EXPECT_FALSE(verifyWesolowski(100, 10, msg, N, {}));
+  auto sol2 = *sol, sol3 = *sol, sol4 = *sol;
+  sol2.first[0]++;
+  sol3.second[0]++;
+  sol4.first.insert(sol4.first.begin(), 0);
+  EXPECT_FALSE(verifyWesolowski(100, 10, msg, N, sol2));
+  EXPECT_FALSE(verifyWesolowski(100, 10, msg, N, sol3));
+  EXPECT_FALSE(verifyWesolowski(100, 10, msg, N, sol4));
+
+  cancelled = true;
+  EXPECT_FALSE(proveWesolowski(100, 10, msg, N, cancelled).has_value());
+}
+
 TEST_F(CryptoTest, vrf_proof_verify) {
   auto [pk, sk] = getVrfKeyPair();
   auto pk2 = getVrfPublicKey(sk);
@@ -174,6 +198,40 @@ TEST_F(CryptoTest, vdf_proof_verify) {
   EXPECT_FALSE(vdf2.verifyVdf(vdf_config, getRlpBytes(level), vdf_input.asBytes()));
 }
 
+TEST_F(CryptoTest, vdf_cancel) {
+  // Always stale, so the difficulty is high enough to take seconds
+  vdf_sortition::VdfConfig vdf_config(0, 0, 0, 1, 20, 1500);
+  vrf_sk_t sk(
+      "0b6627a6680e01cea3d9f36fa797f7f34e8869c3a526d9ed63ed8170e35542aad05dc12c"
+      "1df1edc9f3367fba550b7971fc2de6c5998d8784051c5be69abc9644");
+  level_t level = 1;
+  VdfSortition vdf(vdf_config, node_key.address(), sk, getRlpBytes(level));
+  blk_hash_t vdf_input = blk_hash_t(200);
+  ASSERT_TRUE(vdf.isStale(vdf_config));
+
+  std::atomic_bool cancelled = false;
+  std::atomic_bool computed = true;
+  std::chrono::steady_clock::time_point finished;
+  std::thread th([&] {
+    computed = vdf.computeVdfSolution(vdf_config, vdf_input.asBytes(), cancelled);
+    finished = std::chrono::steady_clock::now();
+  });
+  thisThreadSleepForMilliSeconds(200);
+  auto const cancelled_at = std::chrono::steady_clock::now();
+  cancelled = true;
+  th.join();
+  auto const latency = std::chrono::duration_cast<std::chrono::milliseconds>(finished - cancelled_at);
+  EXPECT_FALSE(computed);
+  EXPECT_LT(latency, std::chrono::milliseconds(50));
+  EXPECT_FALSE(vdf.verifyVdf(vdf_config, getRlpBytes(level), vdf_input.asBytes()));
+
+  // Nothing keeps squaring once the call returned, the process stays idle
+  auto const cpu_before = std::clock();
+  thisThreadSleepForMilliSeconds(500);
+  auto const cpu_used_ms = (std::clock() - cpu_before) * 1000 / CLOCKS_PER_SEC;
+  EXPECT_LT(cpu_used_ms, 100);
+}
+
 TEST_F(CryptoTest, DISABLED_compute_vdf_solution_cost_time) {
   vrf_sk_t sk(
       "0b6627a6680e01cea3d9f36fa797f7f34e8869c3a526d9ed63ed8170e35542aad05dc12c"
@@ -5,6 +5,7 @@
 #include "common/static_init.hpp"
 #include "common/types.hpp"
 #include "logger/log.hpp"
+#include "util/flat_hash.hpp"
 #include "util_test/util.hpp"
 
 namespace taraxa::core_tests {
@@ -361,6 +362,57 @@ TEST_F(DagTest, get_latest_pivot_tips) {
   EXPECT_EQ(tips[0], "0000000000000000000000000000000000000000000000000000000000000006");
 }
 
+TEST_F(DagTest, ghost_path_cache) {
+  const std::string GENESIS = "0000000000000000000000000000000000000000000000000000000000000000";
+  auto db_ptr = s_ptr(new DbStorage(data_dir / "db"));
+  auto mgr = std::make_shared<DagManager>(GENESIS, addr_t(), nullptr, nullptr, db_ptr);
+
+  DagBlock blk1(blk_hash_t(0), 0, {}, {}, sig_t(0), blk_hash_t(1), addr_t(15));
+  DagBlock blk2(blk_hash_t(1), 0, {}, {}, sig_t(1), blk_hash_t(2), addr_t(15));
+  DagBlock blk3(blk_hash_t(2), 0, {}, {}, sig_t(1), blk_hash_t(3), addr_t(15));
+  mgr->addDagBlock(blk1);
+  mgr->addDagBlock(blk2);
+
+  auto ghost = mgr->getGhostPath(blk_hash_t(0));
+  EXPECT_EQ(*ghost, std::vector<blk_hash_t>({blk_hash_t(0), blk_hash_t(1), blk_hash_t(2)}));
+  // Same anchor and unchanged DAG share the path
+  EXPECT_EQ(mgr->getGhostPath(blk_hash_t(0)), ghost);
+  EXPECT_EQ(*mgr->getGhostPath(blk_hash_t(1)), std::vector<blk_hash_t>({blk_hash_t(1), blk_hash_t(2)}));
+
+  // Adding a block invalidates the cached path
+  mgr->addDagBlock(blk3);
+  auto new_ghost = mgr->getGhostPath(blk_hash_t(0));
+  EXPECT_NE(new_ghost, ghost);
+  EXPECT_EQ(new_ghost->back(), blk_hash_t(3));
+  EXPECT_EQ(ghost->back(), blk_hash_t(2));
+}
+
+TEST_F(DagTest, flat_hash_containers) {
+  util::FlatHashSet<blk_hash_t> set;
+  util::FlatHashMap<blk_hash_t, uint64_t> map(10);
+  // Sequential hashes share the leading bytes, so all of them collide and grow the set through long probe sequences
+  for (uint64_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(set.insert(blk_hash_t(i)));
+    map[blk_hash_t(i)] = i;
+  }
+  EXPECT_FALSE(set.insert(blk_hash_t(7)));
+  EXPECT_EQ(set.size(), 1000);
+  EXPECT_EQ(map.size(), 1000);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(set.count(blk_hash_t(i)), 1);
+    ASSERT_TRUE(map.find(blk_hash_t(i)));
+    EXPECT_EQ(*map.find(blk_hash_t(i)), i);
+  }
+  EXPECT_EQ(set.count(blk_hash_t(1000)), 0);
+  EXPECT_FALSE(map.find(blk_hash_t(1000)));
+  uint64_t sum = 0;
+  map.forEach([&](auto const&, auto v) { sum += v; });
+  EXPECT_EQ(sum, 999 * 1000 / 2);
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.insert(blk_hash_t(7)));
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
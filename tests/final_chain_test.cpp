@@ -5,6 +5,7 @@
 #include <optional>
 #include <vector>
 
+#include "aleth/filter_api.hpp"
 #include "chain/chain_config.hpp"
 #include "util_test/gtest.hpp"
 
@@ -49,26 +50,26 @@ struct FinalChainTest : WithDataDir {
     EXPECT_EQ(blk_h.number(), expected_blk_num);
     EXPECT_EQ(blk_h.author(), author);
     EXPECT_EQ(blk_h.timestamp(), timestamp);
-    EXPECT_EQ(result.receipts.size(), trxs.size());
+    EXPECT_EQ(result.receipts->size(), trxs.size());
     EXPECT_EQ(blk_h.transactionsRoot(),
               trieRootOver(
                   trxs.size(), [&](auto i) { return rlp(i); }, [&](auto i) { return trxs[i].rlp(); }));
     EXPECT_EQ(blk_h.receiptsRoot(),
               trieRootOver(
-                  trxs.size(), [&](auto i) { return rlp(i); }, [&](auto i) { return result.receipts[i].rlp(); }));
+                  trxs.size(), [&](auto i) { return rlp(i); }, [&](auto i) { return (*result.receipts)[i].rlp(); }));
     EXPECT_EQ(blk_h.gasLimit(), std::numeric_limits<uint64_t>::max());
     EXPECT_EQ(blk_h.extraData(), bytes());
     EXPECT_EQ(blk_h.nonce(), Nonce());
     EXPECT_EQ(blk_h.difficulty(), 0);
     EXPECT_EQ(blk_h.mixHash(), h256());
     EXPECT_EQ(blk_h.sha3Uncles(), EmptyListSHA3);
-    EXPECT_EQ(blk_h.gasUsed(), result.receipts.empty() ? 0 : result.receipts.back().cumulativeGasUsed());
+    EXPECT_EQ(blk_h.gasUsed(), result.receipts->empty() ? 0 : result.receipts->back().cumulativeGasUsed());
     LogBloom expected_block_log_bloom;
     unordered_map<addr_t, u256> expected_balance_changes;
     unordered_set<addr_t> all_addrs_w_changed_balance;
     for (size_t i = 0; i < trxs.size(); ++i) {
       auto const& trx = trxs[i];
-      auto const& r = result.receipts[i];
+      auto const& r = (*result.receipts)[i];
       EXPECT_EQ(r.rlp(), SUT->transactionReceipt(trx.sha3()).rlp());
       EXPECT_EQ(trx.rlp(), SUT->transaction(trx.sha3()).rlp());
       if (assume_only_toplevel_transfers && trx.value() != 0 && r.statusCode() == 1) {
@@ -107,7 +108,7 @@ struct FinalChainTest : WithDataDir {
       EXPECT_EQ(r_from_db.statusCode(), r.statusCode());
       EXPECT_EQ(r_from_db.gasUsed(), result.state_transition_result.ExecutionResults[i].GasUsed);
       EXPECT_EQ(r_from_db.gasUsed(),
-                i == 0 ? r.cumulativeGasUsed() : r.cumulativeGasUsed() - result.receipts[i - 1].cumulativeGasUsed());
+                i == 0 ? r.cumulativeGasUsed() : r.cumulativeGasUsed() - (*result.receipts)[i - 1].cumulativeGasUsed());
     }
     expected_block_log_bloom.shiftBloom<3>(sha3(blk_h.author().ref()));
     EXPECT_EQ(blk_h.logBloom(), expected_block_log_bloom);
@@ -271,6 +272,118 @@ TEST_F(FinalChainTest, coin_transfers) {
   });
 }
 
+TEST_F(FinalChainTest, logs_index) {
+  auto sender_keys = KeyPair::create();
+  cfg.state.genesis_balances = {};
+  cfg.state.genesis_balances[sender_keys.address()] = 100000;
+  cfg.state.dpos = nullopt;
+  init();
+  h256 const topic_a(1), topic_b(2);
+  // Creation of a contract which init code emits a single log: PUSH32 topic, PUSH1 0, PUSH1 0, LOG1, STOP
+  auto emit = [&](h256 const& topic) {
+    auto code = bytes{0x7f} + topic.asBytes() + bytes{0x60, 0x00, 0x60, 0x00, 0xa1, 0x00};
+    return dev::eth::Transaction(0, 0, 100000, code, 0, sender_keys.secret());
+  };
+  advance_check_opts const with_logs{true};
+  auto const emitter_1 = advance({emit(topic_a)}, with_logs).receipts->front().contractAddress();
+  advance({});
+  auto const emitter_3 = advance({emit(topic_b)}, with_logs).receipts->front().contractAddress();
+  advance({emit(topic_a), emit(topic_b)}, with_logs);
+
+  auto blocks_of = [](LocalisedLogEntries const& logs) {
+    vector<BlockNumber> ret;
+    for (auto const& l : logs) {
+      ret.push_back(l.blockNumber);
+    }
+    return ret;
+  };
+  EXPECT_EQ(blocks_of(SUT->logs(LogFilter(), 0, 4)), (vector<BlockNumber>{1, 3, 4, 4}));
+  EXPECT_EQ(blocks_of(SUT->logs(LogFilter().topic(0, topic_a), 0, 4)), (vector<BlockNumber>{1, 4}));
+  EXPECT_EQ(blocks_of(SUT->logs(LogFilter().topic(0, topic_a), 2, 3)), vector<BlockNumber>());
+  EXPECT_EQ(blocks_of(SUT->logs(LogFilter().topic(0, topic_b), 2, 4)), (vector<BlockNumber>{3, 4}));
+  auto const logs_of_3 = SUT->logs(LogFilter().address(emitter_3), 0, 4);
+  ASSERT_EQ(logs_of_3.size(), 1);
+  EXPECT_EQ(logs_of_3[0].address, emitter_3);
+  EXPECT_EQ(logs_of_3[0].topics, h256s{topic_b});
+  EXPECT_EQ(logs_of_3[0].blockHash, SUT->blockHeader(3).hash());
+  EXPECT_TRUE(SUT->logs(LogFilter().address(emitter_1).topic(0, topic_b), 0, 4).empty());
+  // Blocks are not decoded anymore once more than max_count logs are found
+  EXPECT_EQ(blocks_of(SUT->logs(LogFilter(), 0, 4, 1)), (vector<BlockNumber>{1, 3}));
+  EXPECT_EQ(SUT->logs(LogFilter(), 0, 4, 4).size(), 4);
+}
+
+TEST_F(FinalChainTest, logs_query_json) {
+  Address const emitter(1);
+  h256 const topic_a(1), topic_b(2);
+  Json::Value json;
+  json["fromBlock"] = "0x2";
+  json["toBlock"] = "latest";
+  json["address"] = toJS(emitter);
+  json["topics"].append(Json::Value());
+  json["topics"].append(Json::Value(Json::arrayValue));
+  json["topics"][1].append(toJS(topic_a));
+  json["topics"][1].append(toJS(topic_b));
+  auto const query = aleth::LogsQuery::fromJson(json);
+  EXPECT_EQ(query.from, 2);
+  EXPECT_EQ(query.to, nullopt);
+  auto const receipt = [&](Address const& address, h256s const& topics) {
+    return TransactionReceipt(true, 0, LogEntries{LogEntry(address, topics, bytes())}, Address());
+  };
+  EXPECT_EQ(query.filter.matches(receipt(emitter, {h256(7), topic_b})).size(), 1);
+  EXPECT_TRUE(query.filter.matches(receipt(emitter, {topic_b, h256(7)})).empty());
+  EXPECT_TRUE(query.filter.matches(receipt(Address(2), {h256(7), topic_a})).empty());
+  EXPECT_EQ(aleth::LogsQuery::fromJson(Json::Value(Json::objectValue)).from, nullopt);
+}
+
+TEST_F(FinalChainTest, filter_api) {
+  auto api = aleth::NewFilterAPI({2, 1s, 3});
+  auto const changes_of = [&](aleth::FilterAPI::FilterID id) {
+    vector<string> ret;
+    api->poll(id, [&](Json::Value const& change) {
+      ret.push_back(change.isObject() ? change["transactionHash"].asString() : change.asString());
+    });
+    return ret;
+  };
+  auto const blk_filter = api->newBlockFilter();
+  auto const trx_filter = api->newPendingTransactionFilter();
+  api->note_block(h256(1), 1);
+  api->note_pending_transactions(vector{h256(2)});
+  EXPECT_EQ(changes_of(blk_filter), vector{toJS(h256(1))});
+  EXPECT_EQ(changes_of(trx_filter), vector{toJS(h256(2))});
+  // Changes are consumed by the poll
+  EXPECT_TRUE(changes_of(blk_filter).empty());
+
+  // Only the last max_changes changes are kept between polls
+  for (uint64_t i = 2; i <= 6; ++i) {
+    api->note_block(h256(i), i);
+  }
+  EXPECT_EQ(changes_of(blk_filter), (vector{toJS(h256(4)), toJS(h256(5)), toJS(h256(6))}));
+
+  // Full table makes room for a new filter by uninstalling the least recently polled one
+  this_thread::sleep_for(1ms);
+  changes_of(trx_filter);
+  Json::Value json;
+  json["topics"].append(toJS(h256(5)));
+  auto const logs_filter = api->newLogFilter(aleth::LogsQuery::fromJson(json));
+  EXPECT_FALSE(api->uninstallFilter(blk_filter));
+  EXPECT_TRUE(api->getLogFilter(logs_filter).has_value());
+  api->note_pending_transactions(vector{h256(3)});
+  EXPECT_EQ(changes_of(trx_filter), vector{toJS(h256(3))});
+
+  // Logs filter gets the matching logs of the noted receipts only
+  api->note_block(h256(7), 7);
+  api->note_receipts(vector{h256(11), h256(12)},
+                     vector{TransactionReceipt(true, 0, LogEntries{LogEntry(Address(1), {h256(4)}, {})}, Address()),
+                            TransactionReceipt(true, 0, LogEntries{LogEntry(Address(1), {h256(5)}, {})}, Address())});
+  EXPECT_EQ(changes_of(logs_filter), vector{toJS(h256(12))});
+
+  // Filters which are not polled for the idle timeout are uninstalled
+  this_thread::sleep_for(1100ms);
+  api->note_block(h256(8), 8);
+  EXPECT_FALSE(api->uninstallFilter(trx_filter));
+  EXPECT_FALSE(api->uninstallFilter(logs_filter));
+}
+
 }  // namespace taraxa::final_chain
 
 TARAXA_TEST_MAIN({})
@@ -140,18 +140,18 @@ TEST_F(FullNodeTest, db_test) {
   EXPECT_EQ(db.getPbftBlock(pbft_block4.getBlockHash())->rlp(false), pbft_block4.rlp(false));
   // pbft_blocks (head)
   PbftChain pbft_chain(blk_hash_t(0).toString(), addr_t(), db_ptr);
-  db.savePbftHead(pbft_chain.getHeadHash(), pbft_chain.getJsonStr());
-  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getJsonStr());
+  db.savePbftHead(pbft_chain.getHeadHash(), pbft_chain.getRlp());
+  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getRlp());
   batch = db.createWriteBatch();
   pbft_chain.updatePbftChain(blk_hash_t(123));
-  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getJsonStr(), batch);
+  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getRlp(), batch);
   db.commitWriteBatch(batch);
-  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getJsonStr());
+  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getRlp());
   batch = db.createWriteBatch();
   pbft_chain.updateExecutedPbftChainSize();
-  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getJsonStr(), batch);
+  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getRlp(), batch);
   db.commitWriteBatch(batch);
-  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getJsonStr());
+  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getRlp());
   // status
   db.saveStatusField(StatusDbField::TrxCount, 5);
   db.saveStatusField(StatusDbField::ExecutedBlkCount, 6);
@@ -860,6 +860,26 @@ TEST_F(FullNodeTest, single_node_run_two_transactions) {
   });
 }
 
+TEST_F(FullNodeTest, idle_block_proposer) {
+  auto node_cfgs = make_node_cfgs<5, true>(1);
+  FullNode::Handle node(node_cfgs[0], true);
+  auto const &proposer = node->getBlockProposer();
+
+  // Nothing to propose, the proposer should be sleeping until something changes
+  thisThreadSleepForSeconds(1);
+  auto const cpu_time_before = proposer->getWorkerCpuTime();
+  thisThreadSleepForSeconds(3);
+  auto const cpu_time = proposer->getWorkerCpuTime() - cpu_time_before;
+  EXPECT_LT(cpu_time, 30ms);
+  EXPECT_EQ(node->getDagManager()->getNumVerticesInDag().first, 1);
+
+  // It wakes up on a new transaction
+  send_dummy_trx();
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto &ctx) {
+    WAIT_EXPECT_EQ(ctx, node->getDagManager()->getNumVerticesInDag().first, 2);
+  });
+}
+
 TEST_F(FullNodeTest, two_nodes_run_two_transactions) {
   auto node_cfgs = make_node_cfgs<5, true>(2);
   auto nodes = launch_nodes(node_cfgs);
@@ -1114,7 +1134,12 @@ TEST_F(FullNodeTest, db_rebuild) {
   {
     auto node_cfgs = make_node_cfgs<5>(1);
     node_cfgs[0].test_params.rebuild_db = true;
+    auto const rebuild_begin = std::chrono::steady_clock::now();
     auto nodes = launch_nodes(node_cfgs);
+    auto const rebuild_time = std::chrono::steady_clock::now() - rebuild_begin;
+    // Rebuild returns once the last period is committed, without idle waiting
+    EXPECT_EQ(nodes[0]->getPbftChain()->getPbftExecutedChainSize(), pbft_chain_size);
+    EXPECT_LT(rebuild_time, pbft_chain_size * 1s);
   }
 
   {
@@ -1139,6 +1164,52 @@ TEST_F(FullNodeTest, db_rebuild) {
   }
 }  // namespace taraxa::core_tests
 
+TEST_F(FullNodeTest, db_snapshots) {
+  uint64_t pbft_chain_size = 0;
+  {
+    auto node_cfgs = make_node_cfgs<5>(1);
+    auto nodes = launch_nodes(node_cfgs);
+    auto const &node = nodes[0];
+    auto trxs_count = 0;
+    EXPECT_HAPPENS({60s, 100ms}, [&](auto &ctx) {
+      Transaction dummy_trx(trxs_count++, 0, 2, 100000, bytes(), node->getSecretKey(), node->getAddress());
+      node->getTransactionManager()->insertTransaction(dummy_trx, false);
+      WAIT_EXPECT_EQ(ctx, node->getPbftChain()->getPbftExecutedChainSize() >= 10, true);
+    });
+    EXPECT_HAPPENS({60s, 1s}, [&](auto &ctx) {
+      WAIT_EXPECT_EQ(ctx, node->getDB()->getNumTransactionExecuted(), trxs_count);
+    });
+    pbft_chain_size = node->getPbftChain()->getPbftExecutedChainSize();
+  }
+
+  // Rebuild executes the whole chain without idle waiting, so its duration is the execution time of the periods
+  auto const node_cfgs = make_node_cfgs<5>(1);
+  auto const rebuild_time = [&](uint32_t db_snapshot_each_n_pbft_block) {
+    auto cfgs = node_cfgs;
+    cfgs[0].test_params.rebuild_db = true;
+    cfgs[0].test_params.db_snapshot_each_n_pbft_block = db_snapshot_each_n_pbft_block;
+    cfgs[0].test_params.db_max_snapshots = 2;
+    auto const begin = std::chrono::steady_clock::now();
+    auto nodes = launch_nodes(cfgs);
+    auto const time = std::chrono::steady_clock::now() - begin;
+    EXPECT_EQ(nodes[0]->getPbftChain()->getPbftExecutedChainSize(), pbft_chain_size);
+    return time;
+  };
+  auto const time_without_snapshots = rebuild_time(0);
+  auto const time_with_snapshots = rebuild_time(1);
+  // A snapshot every period only adds the checkpoints of the DB and the state DB, old snapshots are deleted by
+  // another thread
+  EXPECT_LT(time_with_snapshots - time_without_snapshots, std::chrono::milliseconds(100 * pbft_chain_size));
+
+  // The node is closed, the deletion requested with the last snapshot is done by then
+  size_t db_snapshots = 0;
+  for (auto const &entry : fs::directory_iterator(node_cfgs[0].db_path)) {
+    auto const name = entry.path().filename().string();
+    db_snapshots += name.size() > 2 && name.rfind("db", 0) == 0 && std::isdigit(name[2]);
+  }
+  EXPECT_EQ(db_snapshots, 2);
+}
+
 TEST_F(FullNodeTest, transfer_to_self) {
   auto node_cfgs = make_node_cfgs<5, true>(3);
   auto nodes = launch_nodes(node_cfgs);
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -11,7 +12,9 @@
 #include "consensus/pbft_manager.hpp"
 #include "dag/dag.hpp"
 #include "logger/log.hpp"
+#include "network/network_metrics.hpp"
 #include "util/lazy.hpp"
+#include "util/rotating_bloom_filter.hpp"
 #include "util_test/samples.hpp"
 #include "util_test/util.hpp"
 
@@ -337,8 +340,7 @@ TEST_F(NetworkTest, node_pbft_sync) {
   pbft_chain1->updatePbftChain(pbft_block1.getBlockHash());
   // Update PBFT chain head block
   blk_hash_t pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  std::string pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getRlp(), batch);
   db1->commitWriteBatch(batch);
   int expect_pbft_chain_size = 1;
   EXPECT_EQ(node1->getPbftChain()->getPbftChainSize(), expect_pbft_chain_size);
@@ -375,8 +377,7 @@ TEST_F(NetworkTest, node_pbft_sync) {
   pbft_chain1->updatePbftChain(pbft_block2.getBlockHash());
   // Update PBFT chain head block
   pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getRlp(), batch);
   db1->commitWriteBatch(batch);
   expect_pbft_chain_size = 2;
   EXPECT_EQ(node1->getPbftChain()->getPbftChainSize(), expect_pbft_chain_size);
@@ -461,8 +462,7 @@ TEST_F(NetworkTest, node_pbft_sync_without_enough_votes) {
   pbft_chain1->updatePbftChain(pbft_block1.getBlockHash());
   // Update PBFT chain head block
   blk_hash_t pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  std::string pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getRlp(), batch);
   db1->commitWriteBatch(batch);
   int expect_pbft_chain_size = 1;
   EXPECT_EQ(node1->getPbftChain()->getPbftChainSize(), expect_pbft_chain_size);
@@ -497,8 +497,7 @@ TEST_F(NetworkTest, node_pbft_sync_without_enough_votes) {
   pbft_chain1->updatePbftChain(pbft_block2.getBlockHash());
   // Update PBFT chain head block
   pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getRlp(), batch);
   db1->commitWriteBatch(batch);
   expect_pbft_chain_size = 2;
   EXPECT_EQ(node1->getPbftChain()->getPbftChainSize(), expect_pbft_chain_size);
@@ -861,6 +860,33 @@ TEST_F(NetworkTest, node_transaction_sync) {
   }
 }
 
+// Transactions verified before a peer connects are not gossiped anymore, they are sent to the peer on connect
+TEST_F(NetworkTest, node_transaction_sync_on_connect) {
+  auto node_cfgs = make_node_cfgs(2);
+  auto nodes = launch_nodes({node_cfgs[0]});
+  auto& node1 = nodes[0];
+  // Transactions stay in the verified queue instead of being packed into blocks
+  node1->getBlockProposer()->stop();
+
+  std::vector<taraxa::bytes> transactions;
+  for (auto const& t : *g_signed_trx_samples) {
+    transactions.emplace_back(*t.rlp());
+  }
+  node1->getTransactionManager()->insertBroadcastedTransactions(transactions);
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto& ctx) {
+    WAIT_EXPECT_EQ(ctx, node1->getTransactionManager()->getTransactionQueueSize().second, transactions.size());
+  });
+  // Let the periodic gossip take the new transactions while there are no peers
+  thisThreadSleepForMilliSeconds(2 * node_cfgs[0].network.network_transaction_interval + 100);
+
+  FullNode::Handle node2(node_cfgs[1], true);
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto& ctx) {
+    for (auto const& t : *g_signed_trx_samples) {
+      WAIT_EXPECT_EQ(ctx, node2->getTransactionManager()->getTransaction(t.getHash()) != nullptr, true);
+    }
+  });
+}
+
 // Test creates multiple nodes and creates new transactions in random time
 // intervals on randomly selected nodes It verifies that the blocks created from
 // these transactions which get created on random nodes are synced and the
@@ -965,6 +991,219 @@ TEST_F(NetworkTest, node_full_sync) {
   }
 }
 
+// Test verifies that peer known items filter remembers at least one full generation of items and forgets the oldest
+// ones once rotated
+TEST_F(NetworkTest, peer_known_items_filter) {
+  const uint64_t items_per_generation = 1000;
+  util::RotatingBloomFilter<trx_hash_t> filter(items_per_generation, 0.001);
+
+  std::vector<trx_hash_t> first_generation, second_generation;
+  for (uint64_t i = 1; i < items_per_generation; ++i) {
+    first_generation.emplace_back(dev::sha3(dev::toBigEndian(dev::u256(i))));
+    filter.insert(first_generation.back());
+  }
+  for (auto const& hash : first_generation) {
+    EXPECT_TRUE(filter.contains(hash));
+  }
+
+  // Rotation keeps previous generation
+  for (uint64_t i = items_per_generation; i < 2 * items_per_generation; ++i) {
+    second_generation.emplace_back(dev::sha3(dev::toBigEndian(dev::u256(i))));
+    filter.insert(second_generation.back());
+  }
+  for (auto const& hash : first_generation) {
+    EXPECT_TRUE(filter.contains(hash));
+  }
+
+  // Second rotation drops the first generation
+  for (uint64_t i = 2 * items_per_generation; i < 3 * items_per_generation; ++i) {
+    filter.insert(trx_hash_t(dev::sha3(dev::toBigEndian(dev::u256(i)))));
+  }
+  uint64_t still_known = 0;
+  for (auto const& hash : first_generation) {
+    still_known += filter.contains(hash);
+  }
+  EXPECT_LT(still_known, first_generation.size() / 100);
+
+  filter.clear();
+  EXPECT_FALSE(filter.contains(second_generation.back()));
+
+  // Memory must not depend on number of inserted items
+  auto const memory_before = filter.memoryUsage();
+  for (uint64_t i = 0; i < 10 * items_per_generation; ++i) {
+    filter.insert(trx_hash_t(dev::sha3(dev::toBigEndian(dev::u256(i)))));
+  }
+  EXPECT_EQ(memory_before, filter.memoryUsage());
+}
+
+// Out of concurrent insertIfNew calls for the same key only one reports the key as new
+TEST_F(NetworkTest, peer_known_items_insert_if_new) {
+  util::RotatingBloomFilter<trx_hash_t> filter(100000, 0.001);
+  const uint64_t items = 1000;
+  std::atomic<uint64_t> inserted = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (uint64_t i = 0; i < items; ++i) {
+        inserted += filter.insertIfNew(trx_hash_t(dev::sha3(dev::toBigEndian(dev::u256(i)))));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  // False positives may only lower the count
+  EXPECT_LE(inserted, items);
+  EXPECT_GE(inserted, items - items / 100);
+}
+
+// Generations of a time windowed filter rotate once they get older than the max age, even if not full
+TEST_F(NetworkTest, peer_known_items_filter_max_age) {
+  util::RotatingBloomFilter<trx_hash_t> filter(1000, 0.001, 50ms);
+  auto const hash = [](uint64_t i) { return trx_hash_t(dev::sha3(dev::toBigEndian(dev::u256(i)))); };
+
+  filter.insert(hash(1));
+  thisThreadSleepForMilliSeconds(60);
+  filter.insert(hash(2));
+  EXPECT_TRUE(filter.contains(hash(1)));
+  EXPECT_TRUE(filter.contains(hash(2)));
+
+  thisThreadSleepForMilliSeconds(60);
+  filter.insert(hash(3));
+  EXPECT_FALSE(filter.contains(hash(1)));
+  EXPECT_TRUE(filter.contains(hash(3)));
+}
+
+// PbftBlockPacket items assembled from pinned values are byte-identical to the ones assembled from copied values
+TEST_F(NetworkTest, encode_pbft_blocks_pinned) {
+  auto node_cfgs = make_node_cfgs<5>(1);
+  auto nodes = launch_nodes(node_cfgs);
+  auto const& node = nodes[0];
+  uint64_t nonce = 0;
+  EXPECT_HAPPENS({60s, 500ms}, [&](auto& ctx) {
+    Transaction trx(nonce++, 0, 2, 100000, bytes(), node->getSecretKey(), node->getAddress());
+    node->getTransactionManager()->insertTransaction(trx, false);
+    if (node->getPbftChain()->getPbftChainSize() < 3) {
+      ctx.fail();
+    }
+  });
+  auto const pbft_cert_blks = node->getPbftChain()->getPbftBlocks(1, 3);
+  ASSERT_EQ(pbft_cert_blks.size(), 3);
+
+  RLPStream pinned;
+  node->getNetwork()->getTaraxaCapability()->encodePbftBlocks(pbft_cert_blks, pinned);
+
+  // Encoding from copied and decoded values
+  DbStorage::MultiGetQuery db_query(node->getDB());
+  for (auto const& b : pbft_cert_blks) {
+    db_query.append(DbStorage::Columns::dag_finalized_blocks, b.pbft_blk->getPivotDagBlockHash());
+  }
+  auto level_0_extra = db_query.execute();
+  std::vector<uint> edges_0_to_1{0};
+  for (auto const& extra : level_0_extra) {
+    db_query.append(DbStorage::Columns::dag_blocks, RLP(extra).toVector<h256>());
+    edges_0_to_1.push_back(db_query.size());
+  }
+  auto level_1 = db_query.execute();
+  std::vector<uint> edges_1_to_2{0};
+  for (auto const& dag_blk_raw : level_1) {
+    db_query.append(DbStorage::Columns::transactions, DagBlock::extract_transactions_from_rlp(RLP(dag_blk_raw)));
+    edges_1_to_2.push_back(db_query.size());
+  }
+  auto level_2 = db_query.execute();
+  RLPStream copied;
+  for (uint i_0 = 0; i_0 < pbft_cert_blks.size(); ++i_0) {
+    copied.appendList(2);
+    copied.appendRaw(pbft_cert_blks[i_0].rlp());
+    copied.appendList(edges_0_to_1[i_0 + 1] - edges_0_to_1[i_0]);
+    for (uint i_1 = edges_0_to_1[i_0]; i_1 < edges_0_to_1[i_0 + 1]; ++i_1) {
+      copied.appendList(2);
+      copied.appendRaw(level_1[i_1]);
+      copied.appendList(edges_1_to_2[i_1 + 1] - edges_1_to_2[i_1]);
+      for (uint i_2 = edges_1_to_2[i_1]; i_2 < edges_1_to_2[i_1 + 1]; ++i_2) {
+        copied.appendRaw(level_2[i_2]);
+      }
+    }
+  }
+  EXPECT_FALSE(level_2.empty());
+  EXPECT_EQ(pinned.out(), copied.out());
+}
+
+// Eviction follows recency of use, updating a key doesn't leave its old position behind
+TEST_F(NetworkTest, lru_cache) {
+  LruCache<uint64_t, std::string> cache(3);
+  cache.put(1, "a", 1);
+  cache.put(2, "b", 1);
+  cache.put(3, "c", 1);
+  EXPECT_EQ(cache.get(1), "a");
+  cache.put(4, "d", 1);
+  EXPECT_FALSE(cache.get(2));
+  EXPECT_EQ(cache.get(3), "c");
+
+  // Key 1 is the least recently used one, repeated updates of key 4 must not evict others
+  for (int i = 0; i < 10; ++i) {
+    cache.put(4, "e", 1);
+  }
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.weight(), 3);
+  EXPECT_EQ(cache.get(4), "e");
+  cache.put(5, "f", 2);
+  EXPECT_FALSE(cache.get(1));
+  EXPECT_FALSE(cache.get(3));
+  EXPECT_EQ(cache.get(4), "e");
+  EXPECT_EQ(cache.weight(), 3);
+
+  // Too heavy values are not cached
+  cache.put(6, "g", 4);
+  EXPECT_FALSE(cache.get(6));
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(NetworkTest, network_metrics) {
+  NetworkMetrics metrics({"StatusPacket", "TransactionPacket"});
+  NodeID const peer(1);
+  metrics.addPeer(peer);
+  metrics.onReceived(peer, 1, 100);
+  metrics.onReceived(peer, 1, 50);
+  metrics.onSent(peer, 0, 10);
+  // Unknown peers are accounted only per packet type
+  metrics.onSent(NodeID(2), 0, 20);
+  metrics.onHandled(peer, 1, std::chrono::microseconds(7));
+  metrics.onHandled(peer, 1, std::chrono::microseconds(20000));
+  metrics.packet(1).decode.observe(std::chrono::seconds(10));
+
+  EXPECT_EQ(metrics.packet(1).traffic.packets_in, 2);
+  EXPECT_EQ(metrics.packet(1).traffic.bytes_in, 150);
+  EXPECT_EQ(metrics.packet(0).traffic.packets_out, 2);
+  EXPECT_EQ(metrics.packet(0).traffic.bytes_out, 30);
+  EXPECT_EQ(metrics.packet(1).handler.count(), 2);
+  EXPECT_EQ(metrics.packet(1).handler.sumUs(), 20007);
+
+  auto json = metrics.toJson();
+  EXPECT_EQ(json["packets"]["TransactionPacket"]["handler"]["buckets"]["le_10_us"].asUInt64(), 1);
+  EXPECT_EQ(json["packets"]["TransactionPacket"]["handler"]["buckets"]["le_50000_us"].asUInt64(), 1);
+  EXPECT_EQ(json["packets"]["TransactionPacket"]["decode"]["buckets"]["le_inf_us"].asUInt64(), 1);
+  EXPECT_EQ(json["peers"][peer.toString()]["bytes_in"].asUInt64(), 150);
+  EXPECT_EQ(json["peers"][peer.toString()]["bytes_out"].asUInt64(), 10);
+
+  auto prometheus = metrics.toPrometheus();
+  EXPECT_NE(prometheus.find("taraxa_network_packet_bytes_received_total{packet=\"TransactionPacket\"} 150\n"),
+            std::string::npos);
+  // Buckets are cumulative
+  EXPECT_NE(prometheus.find(
+                "taraxa_network_packet_handler_seconds_bucket{packet=\"TransactionPacket\",le=\"+Inf\"} 2\n"),
+            std::string::npos);
+
+  auto const file_path = data_dir / "network_metrics.prom";
+  metrics.dumpPrometheus(file_path.string());
+  std::ifstream file(file_path);
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(file), {}), prometheus);
+
+  metrics.removePeer(peer);
+  EXPECT_EQ(metrics.peer(peer), nullptr);
+  EXPECT_TRUE(metrics.toJson()["peers"].empty());
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
@@ -37,7 +37,7 @@ TEST_F(PbftChainTest, pbft_db_test) {
   auto db = node->getDB();
   std::shared_ptr<PbftChain> pbft_chain = node->getPbftChain();
   blk_hash_t pbft_chain_head_hash = pbft_chain->getHeadHash();
-  std::string pbft_head_from_db = db->getPbftHead(pbft_chain_head_hash);
+  auto pbft_head_from_db = db->getPbftHead(pbft_chain_head_hash);
   EXPECT_FALSE(pbft_head_from_db.empty());
 
   // generate PBFT block sample
@@ -56,8 +56,7 @@ TEST_F(PbftChainTest, pbft_db_test) {
   // Update executed PBFT chain size
   pbft_chain->updateExecutedPbftChainSize();
   // Update PBFT chain head block
-  std::string pbft_chain_head_str = pbft_chain->getJsonStr();
-  db->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain->getRlp(), batch);
   db->commitWriteBatch(batch);
   EXPECT_EQ(pbft_chain->getPbftChainSize(), 1);
   EXPECT_EQ(pbft_chain->getPbftExecutedChainSize(), 1);
@@ -67,7 +66,28 @@ TEST_F(PbftChainTest, pbft_db_test) {
 
   // check pbft genesis update in DB
   pbft_head_from_db = db->getPbftHead(pbft_chain_head_hash);
-  EXPECT_EQ(pbft_head_from_db, pbft_chain->getJsonStr());
+  EXPECT_EQ(pbft_head_from_db, pbft_chain->getRlp());
+}
+
+TEST_F(PbftChainTest, legacy_json_head_upgrade) {
+  auto db = s_ptr(new DbStorage(data_dir));
+  blk_hash_t dag_genesis(1);
+  // Write head record the way previous versions did
+  {
+    PbftChain pbft_chain(dag_genesis.toString(), addr_t(), db);
+    pbft_chain.updatePbftChain(blk_hash_t(123));
+    pbft_chain.updateExecutedPbftChainSize();
+    auto json_str = pbft_chain.getJsonStr();
+    db->savePbftHead(pbft_chain.getHeadHash(), bytes(json_str.begin(), json_str.end()));
+  }
+  PbftChain pbft_chain(dag_genesis.toString(), addr_t(), db);
+  EXPECT_EQ(pbft_chain.getPbftChainSize(), 1);
+  EXPECT_EQ(pbft_chain.getPbftExecutedChainSize(), 1);
+  EXPECT_EQ(pbft_chain.getLastPbftBlockHash(), blk_hash_t(123));
+  // Record is rewritten in binary format on load
+  EXPECT_EQ(db->getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getRlp());
+  PbftChain pbft_chain_reloaded(dag_genesis.toString(), addr_t(), db);
+  EXPECT_EQ(pbft_chain_reloaded.getRlp(), pbft_chain.getRlp());
 }
 
 TEST_F(PbftChainTest, block_broadcast) {
@@ -125,8 +145,7 @@ TEST_F(PbftChainTest, block_broadcast) {
   pbft_chain1->updatePbftChain(pbft_block->getBlockHash());
   // Update PBFT chain head block
   blk_hash_t pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  std::string pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getRlp(), batch);
   db1->commitWriteBatch(batch);
   EXPECT_EQ(pbft_chain1->getPbftChainSize(), 1);
   EXPECT_EQ(pbft_chain1->getPbftExecutedChainSize(), 0);
@@ -163,8 +182,7 @@ TEST_F(PbftChainTest, block_broadcast) {
   pbft_chain2->updatePbftChain(pbft_block->getBlockHash());
   // Update PBFT chain head block
   pbft_chain_head_hash = pbft_chain2->getHeadHash();
-  pbft_chain_head_str = pbft_chain2->getJsonStr();
-  db2->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db2->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain2->getRlp(), batch);
   db2->commitWriteBatch(batch);
   EXPECT_EQ(pbft_chain2->getPbftChainSize(), 1);
   EXPECT_EQ(pbft_chain2->getPbftExecutedChainSize(), 0);
@@ -182,8 +200,7 @@ TEST_F(PbftChainTest, block_broadcast) {
   pbft_chain3->updatePbftChain(pbft_block->getBlockHash());
   // Update PBFT chain head block
   pbft_chain_head_hash = pbft_chain3->getHeadHash();
-  pbft_chain_head_str = pbft_chain3->getJsonStr();
-  db3->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db3->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain3->getRlp(), batch);
   db3->commitWriteBatch(batch);
   EXPECT_EQ(pbft_chain3->getPbftChainSize(), 1);
   EXPECT_EQ(pbft_chain3->getPbftExecutedChainSize(), 0);
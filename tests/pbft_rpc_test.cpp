@@ -60,6 +60,9 @@ TEST_F(PbftRpcTest, add_cleanup_get_votes) {
   // Test add vote
   size_t votes_size = node->getVoteManager()->getUnverifiedVotesSize();
   EXPECT_EQ(votes_size, 6);
+  EXPECT_EQ(vote_mgr->getVotesCount(2, 1), 1);
+  EXPECT_EQ(vote_mgr->getVotesCount(2, 3), 0);
+  EXPECT_EQ(vote_mgr->getVotesCount(4, 1), 0);
 
   // Test get votes
   // CREDENTIAL / SIGNATURE_HASH_MAX <= SORTITION THRESHOLD / VALID PLAYERS
@@ -77,9 +80,12 @@ TEST_F(PbftRpcTest, add_cleanup_get_votes) {
   // Test cleanup votes
   votes_size = node->getVoteManager()->getUnverifiedVotesSize();
   EXPECT_EQ(votes_size, 4);
+  EXPECT_EQ(vote_mgr->getVotesCount(1, 1), 0);
+  EXPECT_EQ(vote_mgr->getVotesCount(3, 2), 1);
   vote_mgr->cleanupVotes(4);  // cleanup round 2 & 3
   votes_size = node->getVoteManager()->getUnverifiedVotesSize();
   EXPECT_EQ(votes_size, 0);
+  EXPECT_EQ(vote_mgr->getVotesCount(3, 2), 0);
 }
 
 TEST_F(PbftRpcTest, reconstruct_votes) {
@@ -1,5 +1,7 @@
 #include "network/rpc/Taraxa.h"
 
+#include <libweb3jsonrpc/JsonHelper.h>
+
 // in our docker build we use libjsonrpccpp 0.7.0, which
 // has the C++17 incompatibility (http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2016/p0003r5.html)
 // in some files that is addressed by the following horrible hack.
@@ -11,6 +13,8 @@
 #undef throw
 // END horrible hack
 
+#include "network/rpc/RpcServer.h"
+#include "network/rpc/WSServer.h"
 #include "util_test/util.hpp"
 
 namespace taraxa::net {
@@ -254,6 +258,224 @@ TEST_F(TaraxaTest, queryDPOS) {
   }
 }
 
+struct RpcServerTest : BaseTest {};
+
+// Responds with the id of the request, later elements of a batch are answered first
+struct ReversedDelayHandler : jsonrpc::IClientConnectionHandler {
+  void HandleRequest(std::string const& request, std::string& response) override {
+    Json::Value req;
+    Json::Reader().parse(request, req);
+    if (!req.isMember("id")) {
+      // Notification
+      return;
+    }
+    thisThreadSleepForMilliSeconds(10 * (5 - req["id"].asUInt()));
+    Json::Value res;
+    res["jsonrpc"] = "2.0";
+    res["id"] = req["id"];
+    res["result"] = req["id"];
+    response = Json::FastWriter().write(res);
+  }
+};
+
+TEST_F(RpcServerTest, batch_response_order) {
+  namespace http = boost::beast::http;
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::endpoint ep{boost::asio::ip::make_address("127.0.0.1"), 17778};
+  ReversedDelayHandler handler;
+  auto rpc = std::make_shared<RpcServer>(io, ep, addr_t());
+  rpc->SetHandler(&handler);
+  rpc->StartListening();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&] { io.run(); });
+  }
+
+  std::string body = "[", expected = "[";
+  for (uint i = 0; i < 5; ++i) {
+    body += (i == 0 ? "" : ",") + fmt(R"({"jsonrpc":"2.0","id":%s,"method":"m","params":[]})", i);
+    // Every element is followed by a notification, which has no response
+    body += R"(,{"jsonrpc":"2.0","method":"n","params":[]})";
+    expected += (i == 0 ? "" : ",") + fmt(R"({"id":%s,"jsonrpc":"2.0","result":%s})", i, i);
+  }
+  body += "]";
+  expected += "]";
+
+  http::request<http::string_body> req{http::verb::post, "/", 11};
+  req.set(http::field::content_type, "application/json");
+  req.body() = body;
+  req.prepare_payload();
+  boost::asio::io_context client_io;
+  boost::beast::tcp_stream stream(client_io);
+  stream.connect(ep);
+  http::write(stream, req);
+  boost::beast::flat_buffer buffer;
+  http::response<http::string_body> res;
+  http::read(stream, buffer, res);
+  EXPECT_EQ(res.body(), expected);
+
+  // Server runs out of work once the connection is closed and it stops accepting
+  stream.close();
+  rpc->StopListening();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+struct WSServerTest : BaseTest {};
+
+// Events spliced from the shared head/tail and the session's subscription id are byte-identical to the notifications
+// serialized as a whole
+TEST_F(WSServerTest, subscription_event_encoding) {
+  auto const check = [](WSSubscription subscription, Json::Value const& result) {
+    auto const subscription_id = dev::toJS(7);
+    WSMessage message{std::make_shared<WSSubscriptionEvent const>(subscription, result), subscription_id};
+    std::string spliced;
+    for (auto const& buffer : message.buffers()) {
+      spliced.append(static_cast<char const*>(buffer.data()), buffer.size());
+    }
+    Json::Value res, params;
+    res["jsonrpc"] = "2.0";
+    res["method"] = "eth_subscription";
+    params["result"] = result;
+    params["subscription"] = subscription_id;
+    res["params"] = params;
+    EXPECT_EQ(spliced, Json::FastWriter().write(res));
+    EXPECT_EQ(message.size(), spliced.size());
+  };
+
+  dev::eth::BlockHeader header;
+  header.setNumber(5);
+  header.setTimestamp(1234);
+  check(WSSubscription::new_heads, dev::eth::toJson(header));
+  check(WSSubscription::new_pending_transactions, Json::Value(dev::toJS(trx_hash_t(1))));
+  DagBlock blk(blk_hash_t(1), 2, {blk_hash_t(3)}, {trx_hash_t(4), trx_hash_t(5)}, sig_t(6), blk_hash_t(7), addr_t(8));
+  check(WSSubscription::new_dag_blocks, blk.getJson());
+  Json::Value finalized;
+  finalized["block"] = dev::toJS(blk_hash_t(1));
+  finalized["period"] = dev::toJS(uint64_t(2));
+  check(WSSubscription::new_dag_blocks_finalized, finalized);
+  PbftBlock pbft_blk(blk_hash_t(1), blk_hash_t(2), 3, addr_t(4), dev::KeyPair::create().secret());
+  Json::Value pbft_result;
+  pbft_result["pbft_block"] = PbftBlock::toJson(pbft_blk, {blk_hash_t(2), blk_hash_t(5)});
+  check(WSSubscription::new_pbft_blocks, pbft_result);
+  // Strings which need escaping
+  check(WSSubscription::new_pending_transactions, Json::Value("\"quoted\" \\ \n\t"));
+}
+
+// WS server with a single client which subscribes to DAG blocks and pending transactions and then stops reading. A
+// huge DAG block event gets stuck in the session's socket, so the pending transaction events after it stay queued
+struct StalledWSClient {
+  static inline DagBlock const huge_blk{blk_hash_t(1), 1, {}, vec_trx_t(150000, trx_hash_t(7)),
+                                        sig_t(1),      blk_hash_t(2), addr_t(3)};
+
+  boost::asio::io_context io;
+  std::shared_ptr<WSServer> server;
+  std::thread io_thread;
+  boost::asio::io_context client_io;
+  websocket::stream<tcp::socket> ws{client_io};
+
+  StalledWSClient(uint16_t port, WSQueueLimits const& limits) {
+    tcp::endpoint ep{boost::asio::ip::make_address("127.0.0.1"), port};
+    server = std::make_shared<WSServer>(io, ep, addr_t(), limits);
+    server->run();
+    io_thread = std::thread([this] { io.run(); });
+    ws.next_layer().open(tcp::v4());
+    ws.next_layer().set_option(boost::asio::socket_base::receive_buffer_size(4096));
+    ws.next_layer().connect(ep);
+    ws.handshake("127.0.0.1", "/");
+    for (auto const& subscription : {"newDagBlocks", "newPendingTransactions"}) {
+      ws.write(boost::asio::buffer(
+          fmt(R"({"jsonrpc":"2.0","id":1,"method":"eth_subscribe","params":["%s"]})", subscription)));
+      beast::flat_buffer buffer;
+      ws.read(buffer);
+    }
+    // Responses are dequeued once their writes complete
+    while (server->getQueueMetrics().queued_messages) {
+      thisThreadSleepForMilliSeconds(1);
+    }
+    server->newDagBlock(huge_blk);
+  }
+
+  ~StalledWSClient() {
+    beast::error_code ec;
+    ws.next_layer().close(ec);
+    io.stop();
+    io_thread.join();
+    server.reset();
+  }
+
+  // Size of queued events, subscription ids are 1 for DAG blocks and 2 for pending transactions
+  static size_t hugeEventSize() {
+    return WSMessage{std::make_shared<WSSubscriptionEvent const>(WSSubscription::new_dag_blocks, huge_blk.getJson()),
+                     dev::toJS(1)}
+        .size();
+  }
+  static size_t trxEventSize() {
+    return WSMessage{std::make_shared<WSSubscriptionEvent const>(WSSubscription::new_pending_transactions,
+                                                                 Json::Value(dev::toJS(trx_hash_t(1)))),
+                     dev::toJS(2)}
+        .size();
+  }
+
+  void emitTransactions(uint64_t count) {
+    for (uint64_t i = 1; i <= count; ++i) {
+      server->newPendingTransaction(trx_hash_t(i));
+    }
+  }
+};
+
+// Queue of a stalled session holds at most 3 messages, the huge event being written and two transaction events
+TEST_F(WSServerTest, session_overflow_drop_oldest) {
+  StalledWSClient client(17780, WSQueueLimits{3, 1 << 30, WSOverflowPolicy::drop_oldest});
+  client.emitTransactions(5);
+  auto const& metrics = client.server->getQueueMetrics();
+  EXPECT_HAPPENS({10s, 10ms}, [&](auto& ctx) {
+    WAIT_EXPECT_EQ(ctx, metrics.dropped_events.load(), 3);
+    WAIT_EXPECT_EQ(ctx, metrics.queued_messages.load(), 3);
+  });
+  EXPECT_EQ(metrics.queued_bytes, StalledWSClient::hugeEventSize() + 2 * StalledWSClient::trxEventSize());
+  EXPECT_EQ(metrics.coalesced_events, 0);
+  EXPECT_EQ(metrics.disconnected_sessions, 0);
+}
+
+TEST_F(WSServerTest, session_overflow_coalesce) {
+  StalledWSClient client(17781, WSQueueLimits{3, 1 << 30, WSOverflowPolicy::coalesce});
+  client.emitTransactions(5);
+  auto const& metrics = client.server->getQueueMetrics();
+  EXPECT_HAPPENS({10s, 10ms}, [&](auto& ctx) {
+    WAIT_EXPECT_EQ(ctx, metrics.coalesced_events.load(), 3);
+    WAIT_EXPECT_EQ(ctx, metrics.queued_messages.load(), 3);
+  });
+  EXPECT_EQ(metrics.dropped_events, 0);
+  EXPECT_EQ(metrics.disconnected_sessions, 0);
+}
+
+TEST_F(WSServerTest, session_overflow_disconnect) {
+  StalledWSClient client(17782, WSQueueLimits{3, 1 << 30, WSOverflowPolicy::disconnect});
+  client.emitTransactions(5);
+  auto const& metrics = client.server->getQueueMetrics();
+  EXPECT_HAPPENS({10s, 10ms}, [&](auto& ctx) { WAIT_EXPECT_EQ(ctx, metrics.disconnected_sessions.load(), 1); });
+  // At most the message which was being written is left until the session is destroyed, closed session gets no events
+  EXPECT_LE(metrics.queued_messages, 1);
+  EXPECT_LE(metrics.queued_bytes, StalledWSClient::hugeEventSize());
+  EXPECT_EQ(metrics.dropped_events, 0);
+  EXPECT_EQ(metrics.coalesced_events, 0);
+}
+
+// Server wide bytes limit drops events before the per session queue gets full
+TEST_F(WSServerTest, session_overflow_max_queued_bytes) {
+  auto const max_queued_bytes = StalledWSClient::hugeEventSize() + 2 * StalledWSClient::trxEventSize();
+  StalledWSClient client(17783, WSQueueLimits{100, max_queued_bytes, WSOverflowPolicy::drop_oldest});
+  client.emitTransactions(5);
+  auto const& metrics = client.server->getQueueMetrics();
+  EXPECT_HAPPENS({10s, 10ms}, [&](auto& ctx) {
+    WAIT_EXPECT_EQ(ctx, metrics.dropped_events.load(), 3);
+    WAIT_EXPECT_EQ(ctx, metrics.queued_messages.load(), 3);
+  });
+  EXPECT_EQ(metrics.queued_bytes, max_queued_bytes);
+}
+
 }  // namespace taraxa::net
 
 TARAXA_TEST_MAIN({});
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <libdevcore/CommonJS.h>
 
+#include <algorithm>
 #include <thread>
 #include <vector>
 
@@ -164,6 +165,65 @@ TEST_F(TransactionTest, transaction_limit) {
   EXPECT_EQ(verified_trxs3.size(), g_trx_samples->size() - 30);
 }
 
+// Transactions rejected by the filter stay in the queue and don't count towards the limit
+TEST_F(TransactionTest, move_verified_trx_snapshot_filter) {
+  TransactionQueue trx_qu(addr_t());
+  for (auto const& t : *g_trx_samples) {
+    trx_qu.insert(t, true);
+  }
+  auto const filter = [](trx_hash_t const& hash) { return hash[0] % 2 == 0; };
+  size_t const accepted = std::count_if(g_trx_samples->begin(), g_trx_samples->end(),
+                                        [&](auto const& t) { return filter(t.getHash()); });
+  ASSERT_GT(accepted, 3u);
+  ASSERT_LT(accepted, NUM_TRX);
+
+  EXPECT_TRUE(trx_qu.hasVerifiedTrx(filter));
+  auto const moved1 = trx_qu.moveVerifiedTrxSnapShot(3, filter);
+  auto const moved2 = trx_qu.moveVerifiedTrxSnapShot(0, filter);
+  EXPECT_EQ(moved1.size(), 3);
+  EXPECT_EQ(moved2.size(), accepted - 3);
+  for (auto const& moved : {moved1, moved2}) {
+    for (auto const& [hash, _] : moved) {
+      EXPECT_TRUE(filter(hash));
+    }
+  }
+  EXPECT_FALSE(trx_qu.hasVerifiedTrx(filter));
+  EXPECT_EQ(trx_qu.getVerifiedTrxCount(), NUM_TRX - accepted);
+  for (auto const& t : *g_trx_samples) {
+    EXPECT_EQ(trx_qu.getTransaction(t.getHash()) != nullptr, !filter(t.getHash()));
+  }
+  EXPECT_EQ(trx_qu.moveVerifiedTrxSnapShot(0).size(), NUM_TRX - accepted);
+}
+
+TEST_F(TransactionTest, new_verified_trx_snapshot) {
+  TransactionManager trx_mgr(s_ptr(new DbStorage(data_dir)), addr_t());
+  trx_mgr.setVerifyMode(TransactionManager::VerifyMode::skip_verify_sig);
+  trx_mgr.start();
+  auto& trx_qu = trx_mgr.getTransactionQueue();
+
+  for (size_t i = 0; i < 10; ++i) {
+    trx_mgr.insertTrx(g_trx_samples[i], true);
+  }
+  EXPECT_EQ(trx_qu.getNewVerifiedTrxSnapShot().size(), 10);
+  // Only transactions verified since the last call are returned
+  EXPECT_TRUE(trx_qu.getNewVerifiedTrxSnapShot().empty());
+
+  for (size_t i = 10; i < 15; ++i) {
+    trx_mgr.insertTrx(g_trx_samples[i], true);
+  }
+  // Packed transactions are not gossiped anymore
+  trx_qu.moveVerifiedTrxSnapShot(0);
+  for (size_t i = 15; i < 20; ++i) {
+    trx_mgr.insertTrx(g_trx_samples[i], true);
+  }
+  auto new_verified_trxs = trx_qu.getNewVerifiedTrxSnapShot();
+  EXPECT_EQ(new_verified_trxs.size(), 5);
+  auto const last_inserted_begin = g_trx_samples->begin() + 15, last_inserted_end = g_trx_samples->begin() + 20;
+  for (auto const& trx : new_verified_trxs) {
+    EXPECT_NE(std::find(last_inserted_begin, last_inserted_end, trx), last_inserted_end);
+  }
+}
+
 TEST_F(TransactionTest, prepare_signed_trx_for_propose) {
   TransactionManager trx_mgr(s_ptr(new DbStorage(data_dir)), addr_t());
   trx_mgr.start();
@@ -192,6 +252,144 @@ TEST_F(TransactionTest, prepare_signed_trx_for_propose) {
   EXPECT_EQ(total_packed_trxs.size(), NUM_TRX) << " Packed Trx: " << ::testing::PrintToString(total_packed_trxs);
 }
 
+TEST_F(TransactionTest, pending_block_index) {
+  auto db = s_ptr(new DbStorage(data_dir));
+  auto const other_key_pair = dev::KeyPair::create();
+  auto const other_trxs = samples::createSignedTrxSamples(0, 3, other_key_pair.secret());
+  auto const& trxs = *g_signed_trx_samples;
+  for (auto const& t : trxs) db->saveTransaction(t);
+  for (auto const& t : other_trxs) db->saveTransaction(t);
+  std::vector<dev::h256> executed;
+  for (unsigned i = 0; i < 10; ++i) {
+    executed.push_back(trxs[i].getHash());
+  }
+  {
+    auto pending_block = aleth::NewPendingBlock(1, addr_t(), dev::h256(), db);
+    pending_block->add_transactions(trxs);
+    pending_block->add_transactions(other_trxs);
+    // Transaction accepted again is not duplicated
+    pending_block->add_transactions(std::vector{trxs[0]});
+    EXPECT_EQ(pending_block->transactionsCount(), NUM_TRX + 3);
+    EXPECT_EQ(pending_block->transactionsCount(g_key_pair->address()), NUM_TRX);
+    EXPECT_EQ(pending_block->transactionsCount(other_key_pair.address()), 3);
+
+    auto batch = DbStorage::createWriteBatch();
+    pending_block->advance(batch, dev::h256(1), executed);
+    db->commitWriteBatch(batch);
+    EXPECT_EQ(pending_block->header().number(), 2);
+    EXPECT_EQ(pending_block->transactionsCount(), NUM_TRX - 10 + 3);
+    EXPECT_EQ(pending_block->transactionsCount(g_key_pair->address()), NUM_TRX - 10);
+    EXPECT_EQ(pending_block->transactions().size(), NUM_TRX - 10 + 3);
+  }
+  // Pending set is restored from the db
+  auto pending_block = aleth::NewPendingBlock(2, addr_t(), dev::h256(1), db);
+  EXPECT_EQ(pending_block->transactionsCount(), NUM_TRX - 10 + 3);
+  EXPECT_EQ(pending_block->transactionsCount(g_key_pair->address()), NUM_TRX - 10);
+  EXPECT_EQ(pending_block->transactionsCount(other_key_pair.address()), 3);
+  auto const hashes = pending_block->transactionHashes();
+  EXPECT_TRUE(std::is_sorted(hashes.begin(), hashes.end()));
+  for (auto const& h : executed) {
+    EXPECT_EQ(std::find(hashes.begin(), hashes.end(), h), hashes.end());
+  }
+}
+
+// Pending set persisted by add_transactions and deletes of the executed transactions made by concurrent advance()
+// calls end up in the db in the order they were applied to the pending set
+TEST_F(TransactionTest, pending_block_concurrent_persist) {
+  auto db = s_ptr(new DbStorage(data_dir));
+  auto const trxs = samples::createSignedTrxSamples(0, 8 * 256, g_secret);
+  for (auto const& t : trxs) db->saveTransaction(t);
+  h256s pending;
+  {
+    auto pending_block = aleth::NewPendingBlock(1, addr_t(), dev::h256(), db);
+    std::atomic<bool> added = false;
+    std::thread add_trxs([&] {
+      for (auto it = trxs.begin(); it != trxs.end(); it += 64) {
+        pending_block->add_transactions(std::vector<Transaction>(it, it + 64));
+      }
+      added = true;
+    });
+    for (uint64_t blk_n = 1; !added; ++blk_n) {
+      // Executes every other pending transaction
+      h256s executed;
+      auto const hashes = pending_block->transactionHashes();
+      for (size_t i = 0; i < hashes.size(); i += 2) {
+        executed.push_back(hashes[i]);
+      }
+      auto batch = DbStorage::createWriteBatch();
+      pending_block->advance(batch, dev::h256(blk_n), executed);
+      db->commitWriteBatch(batch);
+    }
+    add_trxs.join();
+    pending = pending_block->transactionHashes();
+  }
+  EXPECT_EQ(aleth::NewPendingBlock(2, addr_t(), dev::h256(), db)->transactionHashes(), pending);
+}
+
+TEST_F(TransactionTest, status_table_transitions) {
+  auto db = s_ptr(new DbStorage(data_dir));
+  auto const hash = trx_hash_t(1);
+  {
+    TransactionStatusTable table(db, TransactionStatusTable::c_shards_num);
+    EXPECT_EQ(table.get(hash), TransactionStatus::not_seen);
+    EXPECT_TRUE(
+        table.compareAndSet(hash, TransactionStatus::not_seen, TransactionStatus::in_queue_unverified).first);
+    auto [set, status] = table.compareAndSet(hash, TransactionStatus::not_seen, TransactionStatus::in_queue_verified);
+    EXPECT_FALSE(set);
+    EXPECT_EQ(status, TransactionStatus::in_queue_unverified);
+    EXPECT_TRUE(
+        table.compareAndSet(hash, TransactionStatus::in_queue_unverified, TransactionStatus::in_queue_verified).first);
+    // Nothing is written until the group commit
+    EXPECT_EQ(db->getTransactionStatus(hash), TransactionStatus::not_seen);
+    table.flush();
+    EXPECT_EQ(db->getTransactionStatus(hash), TransactionStatus::in_queue_verified);
+    EXPECT_EQ(table.exchange(hash, TransactionStatus::in_block), TransactionStatus::in_queue_verified);
+
+    // Enough changes to trigger the group commit, persisted final statuses are evicted over the capacity
+    for (uint64_t i = 2; i < 2 + TransactionStatusTable::c_flush_batch_size; ++i) {
+      table.exchange(trx_hash_t(i), TransactionStatus::in_block);
+    }
+    EXPECT_EQ(db->getTransactionStatus(hash), TransactionStatus::in_block);
+    EXPECT_EQ(table.get(hash), TransactionStatus::in_block);
+  }
+  // Statuses are loaded from the db
+  TransactionStatusTable table(db);
+  EXPECT_EQ(table.get(hash), TransactionStatus::in_block);
+  EXPECT_FALSE(table.compareAndSet(hash, TransactionStatus::in_queue_verified, TransactionStatus::in_block).first);
+}
+
+// Group commits triggered by the insertions run concurrently with packing. A group commit may still write the queued
+// status read before packTrxs wrote in_block, the entry must stay dirty then so that in_block is written again
+TEST_F(TransactionTest, status_table_flush_while_packing) {
+  auto db = s_ptr(new DbStorage(data_dir));
+  TransactionManager trx_mgr(db, addr_t());
+  trx_mgr.setVerifyMode(TransactionManager::VerifyMode::skip_verify_sig);
+  trx_mgr.start();
+  auto const trxs = samples::createSignedTrxSamples(0, 8 * TransactionStatusTable::c_flush_batch_size, g_secret);
+  std::atomic<bool> inserted = false;
+  std::thread insert_trxs([&] {
+    for (auto const& t : trxs) {
+      trx_mgr.insertTransaction(t, true);
+    }
+    inserted = true;
+  });
+  vec_trx_t total_packed_trxs, packed_trxs;
+  for (bool done = false; !done;) {
+    // Read before packing, so the last packing sees all the transactions
+    done = inserted;
+    trx_mgr.packTrxs(packed_trxs, 16);
+    total_packed_trxs.insert(total_packed_trxs.end(), packed_trxs.begin(), packed_trxs.end());
+    done = done && packed_trxs.empty();
+  }
+  insert_trxs.join();
+  EXPECT_EQ(total_packed_trxs.size(), trxs.size());
+  // Stopping flushes all the dirty entries
+  trx_mgr.stop();
+  for (auto const& hash : total_packed_trxs) {
+    EXPECT_EQ(db->getTransactionStatus(hash), TransactionStatus::in_block);
+  }
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;